@@ -0,0 +1,184 @@
+//orel8155@gmail.com
+/**
+ * @file Action.hpp
+ * @brief Compact description of the moves a player can make on their turn
+ *
+ * Actions are small value types (an action type and a target seat) so that
+ * move lists can be generated, stored and compared without allocation.
+ */
+#pragma once  // Ensures this header file is included only once during compilation
+
+#include <cstddef>   // For size_t
+#include <cstdint>   // For fixed-width integers
+
+namespace coup
+{
+    /**
+     * @enum ActionType
+     * @brief The actions a player can take on their own turn
+     */
+    enum class ActionType : uint8_t
+    {
+        GATHER,    // Collect one coin
+        TAX,       // Collect tax (role-specific amount)
+        BRIBE,     // Pay 4 coins to act again
+        ARREST,    // Arrest another player
+        SANCTION,  // Impose sanctions on another player
+        COUP,      // Eliminate another player
+        INVEST     // Baron's investment
+    };
+
+    /**
+     * Number of action types (size of per-action tables)
+     */
+    constexpr size_t ACTION_TYPE_COUNT = 7;
+
+    /**
+     * Target seat value of actions that have no target
+     */
+    constexpr uint8_t NO_TARGET = 0xFF;
+
+    /**
+     * @struct Action
+     * @brief One move: what to do and, for targeted actions, to which seat
+     */
+    struct Action
+    {
+        ActionType type = ActionType::GATHER;  // The action to perform
+        uint8_t target = NO_TARGET;            // Seat index of the target, or NO_TARGET
+
+        /**
+         * @brief Checks whether the action needs a target
+         * @return True for arrest, sanction and coup
+         */
+        bool hasTarget() const
+        {
+            return type == ActionType::ARREST || type == ActionType::SANCTION || type == ActionType::COUP;
+        }
+
+        bool operator==(const Action &other) const { return type == other.type && target == other.target; }
+        bool operator!=(const Action &other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief Gets the display name of an action type
+     * @param type The action type
+     * @return The action name as used in logs ("gather", "tax", ...)
+     */
+    inline const char *actionName(ActionType type)
+    {
+        switch (type)
+        {
+        case ActionType::GATHER:
+            return "gather";
+        case ActionType::TAX:
+            return "tax";
+        case ActionType::BRIBE:
+            return "bribe";
+        case ActionType::ARREST:
+            return "arrest";
+        case ActionType::SANCTION:
+            return "sanction";
+        case ActionType::COUP:
+            return "coup";
+        case ActionType::INVEST:
+            return "invest";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @class LegalActions
+     * @brief Fixed-capacity list of legal actions with a bitmask of the action types present
+     *
+     * Holds at most the untargeted actions plus every targeted action against
+     * each of the other five seats, so it never allocates.
+     */
+    class LegalActions
+    {
+    public:
+        /**
+         * Maximum number of actions: 4 untargeted + 3 targeted against 5 opponents
+         */
+        static constexpr size_t CAPACITY = 4 + 3 * 5;
+
+        /**
+         * @brief Adds an action to the list
+         * @param action The legal action
+         */
+        void add(Action action)
+        {
+            actions_[size_++] = action;
+            typeMask_ |= static_cast<uint8_t>(1u << static_cast<unsigned>(action.type));
+        }
+
+        /**
+         * @brief Checks whether any action of a type is legal
+         * @param type The action type
+         * @return True if at least one action of that type is in the list
+         */
+        bool has(ActionType type) const { return (typeMask_ >> static_cast<unsigned>(type)) & 1u; }
+
+        /**
+         * @brief Checks whether a specific action is in the list
+         * @param action The action to look for
+         * @return True if the action is legal
+         */
+        bool contains(Action action) const
+        {
+            for (size_t i = 0; i < size_; ++i)
+            {
+                if (actions_[i] == action)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Counts the legal actions of one type
+         * @param type The action type
+         * @return Number of actions of that type
+         */
+        size_t count(ActionType type) const
+        {
+            size_t total = 0;
+            for (size_t i = 0; i < size_; ++i)
+            {
+                total += actions_[i].type == type ? 1 : 0;
+            }
+            return total;
+        }
+
+        /**
+         * @brief Gets the n-th action of one type
+         * @param type The action type
+         * @param n Index among the actions of that type (must be below count(type))
+         * @return The action
+         */
+        Action nth(ActionType type, size_t n) const
+        {
+            for (size_t i = 0; i < size_; ++i)
+            {
+                if (actions_[i].type == type && n-- == 0)
+                {
+                    return actions_[i];
+                }
+            }
+            return actions_[0];
+        }
+
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        uint8_t typeMask() const { return typeMask_; }
+        const Action &operator[](size_t index) const { return actions_[index]; }
+        const Action *begin() const { return actions_; }
+        const Action *end() const { return actions_ + size_; }
+
+    private:
+        Action actions_[CAPACITY];  // The legal actions
+        uint8_t size_ = 0;          // Number of actions in the list
+        uint8_t typeMask_ = 0;      // Bit i is set if an action of type i is present
+    };
+}
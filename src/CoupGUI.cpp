@@ -20,7 +20,9 @@
  */
 
 #include "CoupGUI.hpp"
+#include "MctsBot.hpp"
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <cmath>
 /**
@@ -181,9 +183,9 @@ CoupGUI::CoupGUI(std::shared_ptr<coup::Game> existingGame, std::vector<std::shar
     
     // Set the current player
     if (!realPlayers.empty()) {
-        auto players = game->players();
+        auto players = game->activePlayers();
         if (!players.empty()) {
-            currentPlayerName = players[0];
+            currentPlayerName = (*players.begin())->name();
         } else if (realPlayers[0]) {
             currentPlayerName = realPlayers[0]->name();
         }
@@ -372,7 +374,7 @@ void CoupGUI::initializeBasicActions()
     // Position and size of the buttons - all buttons in one row
     float buttonWidth = 120;
     float buttonHeight = 40;
-    float totalWidth = 6 * buttonWidth + 5 * 10;          // 6 buttons + 5 spaces of 10 pixels
+    float totalWidth = 7 * buttonWidth + 6 * 10;          // 7 buttons + 6 spaces of 10 pixels
     float startX = (window.getSize().x - totalWidth) / 2; // Center of the buttons
     float startY = 640;                                   // Position of the buttons in the action panel
     float spacing = buttonWidth + 10;                     // Space between the buttons
@@ -498,6 +500,25 @@ void CoupGUI::initializeBasicActions()
         startY + (buttonHeight - coupAction.buttonText.getLocalBounds().height) / 2 - 5);
 
     basicActions.push_back(coupAction);
+
+    // 7. Bot move - the MCTS bot plays the current player's turn
+    BasicAction botAction;
+    botAction.name = "Bot Move";
+    botAction.buttonColor = sf::Color(120, 80, 160); // Purple for the bot
+
+    botAction.button.setSize(sf::Vector2f(buttonWidth, buttonHeight));
+    botAction.button.setPosition(startX + spacing * 6, startY);
+    botAction.button.setFillColor(botAction.buttonColor);
+
+    botAction.buttonText.setFont(mainFont);
+    botAction.buttonText.setString(botAction.name);
+    botAction.buttonText.setCharacterSize(18);
+    botAction.buttonText.setFillColor(sf::Color::White);
+    botAction.buttonText.setPosition(
+        startX + spacing * 6 + (buttonWidth - botAction.buttonText.getLocalBounds().width) / 2,
+        startY + (buttonHeight - botAction.buttonText.getLocalBounds().height) / 2 - 5);
+
+    basicActions.push_back(botAction);
 }
 
 /**
@@ -811,15 +832,15 @@ void CoupGUI::run()
                                             // Execute appropriate action based on pending action name
                                             if (pendingActionName == "Arrest")
                                             {
-                                                executeArrest(player);
+                                                executeArrest(player->handle());
                                             }
                                             else if (pendingActionName == "Sanction")
                                             {
-                                                executeSanction(player);
+                                                executeSanction(player->handle());
                                             }
                                             else if (pendingActionName == "Coup")
                                             {
-                                                executeCoup(player);
+                                                executeCoup(player->handle());
                                             }
                                             
                                             // Reset target selection state
@@ -1591,6 +1612,26 @@ void CoupGUI::handleBasicActionClick(int actionIndex)
             createPlayerButtons();
             addNotification("click on a player to perform a coup");
         }
+        else if (actionName == "Bot Move")
+        {
+            // The MCTS bot searches for half a second and plays the current player's turn
+            coup::MctsConfig config;
+            config.maxPlayouts = 0;
+            config.maxMillis = 500;
+            config.seed = std::random_device{}();
+            coup::MctsBot bot(config);
+            coup::Action move = bot.chooseAction(*game);
+
+            std::string targetName = move.hasTarget() ? game->getPlayers()[move.target]->name() : "";
+            coup::throwIfFailed(game->apply(move));
+            game->clearJournal(); // The GUI does not rewind bot moves
+            addLogMessage(currentPlayerName + " (bot) chose " + coup::actionName(move.type) +
+                          (targetName.empty() ? "" : " on " + targetName));
+
+            // Update current player name after the action
+            currentPlayer = game->getPlayer();
+            currentPlayerName = currentPlayer->name();
+        }
         
         // Notify the user of successful action and next player's turn
         addNotification(action.name + " action succeeded. Next player: " + currentPlayerName);
@@ -1733,23 +1774,23 @@ void CoupGUI::drawPlayerButtons()
  * This function handles the process of arresting another player
  * and updates the game state accordingly
  *
- * @param targetPlayer The player who will be arrested
+ * @param targetPlayer Handle of the player who will be arrested
  */
-void CoupGUI::executeArrest(std::shared_ptr<coup::Player> targetPlayer)
+void CoupGUI::executeArrest(coup::PlayerHandle targetPlayer)
 {
     try {
-        // Get current player from the game
-        auto currentPlayer = game->getPlayer();
+        // Get current player from the game; a stale target handle throws PlayerNotFound
+        coup::Player &currentPlayer = game->player(game->currentPlayer());
+        const std::string &targetName = game->player(targetPlayer).name();
         
         // Execute the arrest action
-        currentPlayer->arrest(targetPlayer);
-        addLogMessage(currentPlayerName + " arrested " + targetPlayer->name());
+        currentPlayer.arrest(targetPlayer);
+        addLogMessage(currentPlayerName + " arrested " + targetName);
         
         // Update current player name after the action
         // This is needed because turns change after actions
         try {
-            currentPlayer = game->getPlayer();
-            currentPlayerName = currentPlayer->name();
+            currentPlayerName = game->player(game->currentPlayer()).name();
         } catch (const std::exception &e) {
             // If there's an error updating, continue with existing name
         }
@@ -1766,23 +1807,23 @@ void CoupGUI::executeArrest(std::shared_ptr<coup::Player> targetPlayer)
  * This function handles applying sanctions to another player
  * and updates the game state accordingly
  *
- * @param targetPlayer The player who will be sanctioned
+ * @param targetPlayer Handle of the player who will be sanctioned
  */
-void CoupGUI::executeSanction(std::shared_ptr<coup::Player> targetPlayer)
+void CoupGUI::executeSanction(coup::PlayerHandle targetPlayer)
 {
     try {
-        // Get current player from the game
-        auto currentPlayer = game->getPlayer();
+        // Get current player from the game; a stale target handle throws PlayerNotFound
+        coup::Player &currentPlayer = game->player(game->currentPlayer());
+        const std::string &targetName = game->player(targetPlayer).name();
         
         // Execute the sanction action
-        currentPlayer->sanction(*targetPlayer);
-        addLogMessage(currentPlayerName + " sanctioned " + targetPlayer->name());
+        currentPlayer.sanction(targetPlayer);
+        addLogMessage(currentPlayerName + " sanctioned " + targetName);
         
         // Update current player name after the action
         // This is needed because turns change after actions
         try {
-            currentPlayer = game->getPlayer();
-            currentPlayerName = currentPlayer->name();
+            currentPlayerName = game->player(game->currentPlayer()).name();
         } catch (const std::exception &e) {
             // If there's an error updating, continue with existing name
         }
@@ -1799,23 +1840,23 @@ void CoupGUI::executeSanction(std::shared_ptr<coup::Player> targetPlayer)
  * This function handles the process of eliminating another player
  * from the game and updates the game state accordingly
  *
- * @param targetPlayer The player who will be eliminated with a coup
+ * @param targetPlayer Handle of the player who will be eliminated with a coup
  */
-void CoupGUI::executeCoup(std::shared_ptr<coup::Player> targetPlayer)
+void CoupGUI::executeCoup(coup::PlayerHandle targetPlayer)
 {
     try {
-        // Get current player from the game
-        auto currentPlayer = game->getPlayer();
+        // Get current player from the game; a stale target handle throws PlayerNotFound
+        coup::Player &currentPlayer = game->player(game->currentPlayer());
+        const std::string &targetName = game->player(targetPlayer).name();
         
         // Execute the coup action
-        currentPlayer->coup(targetPlayer);
-        addLogMessage(currentPlayerName + " performed coup on " + targetPlayer->name());
+        currentPlayer.coup(targetPlayer);
+        addLogMessage(currentPlayerName + " performed coup on " + targetName);
         
         // Update current player name after the action
         // This is needed because turns change after actions
         try {
-            currentPlayer = game->getPlayer();
-            currentPlayerName = currentPlayer->name();
+            currentPlayerName = game->player(game->currentPlayer()).name();
         } catch (const std::exception &e) {
             // If there's an error updating, continue with existing name
         }
@@ -2146,28 +2187,9 @@ void CoupGUI::resetGame()
             return;
         }
 
-        // Store existing player data
-        std::vector<std::string> playerNames;
-        std::vector<coup::Role> playerRoles;
-        
-        for (const auto& player : realPlayers) {
-            if (player) {
-                playerNames.push_back(player->name());
-                playerRoles.push_back(player->role());
-            }
-        }
-        
-        // Create a new game instance
-        game = std::make_shared<coup::Game>();
-        
-        // Clear the old players list
-        realPlayers.clear();
-        
-        // Create new players with the same names and roles
-        for (size_t i = 0; i < playerNames.size(); i++) {
-            auto newPlayer = game->createPlayer(playerNames[i], playerRoles[i]);
-            realPlayers.push_back(newPlayer);
-        }
+        // Restart the game in place; the players keep their names, roles and seats
+        selectedPerformer = nullptr;
+        game->reset();
 
         // Return to normal play state
         currentState = GuiState::PLAYING;
@@ -2206,20 +2228,10 @@ void CoupGUI::checkForWinner()
         return;
     }
 
-    // Count active players
-    int activePlayers = 0;
-    std::shared_ptr<coup::Player> lastActivePlayer = nullptr;
-
-    for (const auto& player : realPlayers) {
-        if (player && player->isActive()) {
-            activePlayers++;
-            lastActivePlayer = player;
-        }
-    }
-
-    // If only one active player remains, we have a winner
-    if (activePlayers == 1 && lastActivePlayer) {
-        winnerName = lastActivePlayer->name();
+    // If only one active player remains, we have a winner (the game keeps the count)
+    uint8_t survivor = game->lastSurvivorSeat();
+    if (survivor != coup::NO_SEAT) {
+        winnerName = game->getPlayers()[survivor]->name();
         currentState = GuiState::WIN_SCREEN;
         addLogMessage(winnerName + " won the game!");
         addNotification("Game Over! " + winnerName + " is the winner!");
@@ -2239,8 +2251,9 @@ void CoupGUI::startNewGame()
     currentInputText = "";
     
     // Clear game data
-    game = nullptr;
+    selectedPerformer = nullptr;
     realPlayers.clear();
+    game = nullptr;
     setupPlayers.clear();
     
     // Clear temporary states
@@ -2549,9 +2562,10 @@ void CoupGUI::handleTextInput(sf::Uint32 unicode)
 void CoupGUI::createGameFromSetup()
 {
     try {
-        // Create new game instance
-        game = std::make_shared<coup::Game>();
+        // Release the old players and create a new game instance
+        selectedPerformer = nullptr;
         realPlayers.clear();
+        game = std::make_shared<coup::Game>();
         
         // Create players based on configuration
         for (int i = 0; i < numPlayersToSetup; i++) {
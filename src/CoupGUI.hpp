@@ -200,9 +200,9 @@ private:
     void createGameFromSetup(); // Create game from setup configuration
     
     // Functions for actions that require target selection
-    void executeArrest(std::shared_ptr<coup::Player> targetPlayer);
-    void executeSanction(std::shared_ptr<coup::Player> targetPlayer);
-    void executeCoup(std::shared_ptr<coup::Player> targetPlayer);
+    void executeArrest(coup::PlayerHandle targetPlayer);
+    void executeSanction(coup::PlayerHandle targetPlayer);
+    void executeCoup(coup::PlayerHandle targetPlayer);
     
     // Helper functions for player buttons
     void createPlayerButtons(); // Create player buttons
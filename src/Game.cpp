@@ -16,6 +16,71 @@ using namespace std;      // Using standard namespace
 
 namespace coup
 {
+    namespace
+    {
+        /**
+         * Settings of a game's player pool: chunks of at most one table of players,
+         * and blocks large enough for a player with its reference count
+         */
+        const pmr::pool_options PLAYER_POOL_OPTIONS{GameState::MAX_PLAYERS, 512};
+
+        /**
+         * Allocator of a player and its reference count: takes the memory from a
+         * pool and co-owns the pool, so the control block keeps the game's arena
+         * alive until the player is released, even after the game is destroyed
+         */
+        template <class T>
+        struct SharedPoolAllocator
+        {
+            using value_type = T;
+
+            shared_ptr<pmr::memory_resource> pool;  // The pool, sharing ownership of the arena it belongs to
+
+            explicit SharedPoolAllocator(shared_ptr<pmr::memory_resource> resource) : pool(move(resource)) {}
+
+            template <class U>
+            SharedPoolAllocator(const SharedPoolAllocator<U> &other) : pool(other.pool) {}
+
+            T *allocate(size_t count) { return static_cast<T *>(pool->allocate(count * sizeof(T), alignof(T))); }
+            void deallocate(T *memory, size_t count) { pool->deallocate(memory, count * sizeof(T), alignof(T)); }
+
+            template <class U>
+            bool operator==(const SharedPoolAllocator<U> &other) const { return pool == other.pool; }
+            template <class U>
+            bool operator!=(const SharedPoolAllocator<U> &other) const { return pool != other.pool; }
+        };
+    }
+
+    /**
+     * Memory of a game, shared by the game and its players
+     * Members are destroyed in reverse order: the pool returns its chunks to the arena first
+     */
+    struct Game::Arena
+    {
+        alignas(max_align_t) byte buffer[ARENA_BYTES];                      // Storage of the arena
+        pmr::monotonic_buffer_resource arena{buffer, ARENA_BYTES};          // The journal and the pool's chunks
+        pmr::unsynchronized_pool_resource pool{PLAYER_POOL_OPTIONS, &arena}; // Recycles replaced players and names
+    };
+
+    /**
+     * Constructor - Initializes a new game with default values
+     * @param rules The rule values of the game
+     * @throws GameException if the rule values are not valid
+     */
+    Game::Game(const RuleConfig &rules)
+        : arena_(make_shared<Arena>()), current_player_index_(0), previous_player_index_(0), game_started_(false),
+          has_previous_(false), arrested_player_seat_(NO_SEAT), arrested_seat_(NO_SEAT), last_couped_seat_(NO_SEAT),
+          seat_by_name_(&arena_->pool), bank_balance_(INITIAL_BANK), hash_(0), rules_(rules),
+          standard_rules_(rules.isStandard()), journal_(&arena_->arena)
+    {
+        if (!rules_.isValid())
+        {
+            throw GameException("Invalid rule values");
+        }
+        players_.reserve(GameState::MAX_PLAYERS);
+        hash_ = computeHash();
+    }
+
     /**
      * Returns the role of the current player whose turn it is
      * @return The Role enum value of the current player
@@ -54,83 +119,477 @@ namespace coup
             throw GameException("Player name cannot be empty");
         }
 
-        // Check if name already exists and create a unique name
+        // Check if name already exists and create a unique name with a counter
         string unique_name = name;
         int counter = 1;
+        while (seat_by_name_.count(unique_name))
+        {
+            counter++;
+            unique_name = name + "_" + to_string(counter);
+        }
+
+        // Check we don't exceed the maximum player limit
+        if (players_.size() >= DefaultRules::MAX_PLAYERS)
+        {
+            throw GameException("Maximum number of players (" + to_string(DefaultRules::MAX_PLAYERS) + ") reached");
+        }
+
+        shared_ptr<Player> player = makePlayer(unique_name, role);
+
+        // The player took the next seat of the table; make it active and add its fields to the hash
+        updateActiveSeat(player->seat_, true);
+        hash_ ^= playerHash(*player);
+        players_.push_back(player);
+
+        // Index the name by a view of the player's own string, which never changes
+        seat_by_name_.emplace(player->name(), player->seat_);
+        return player;
+    }
+
+    /**
+     * Creates a player object of the class that implements a role
+     * The object and its reference count share one block of the game's player pool,
+     * and the reference count co-owns the game's arena
+     * @param name The player's name
+     * @param role The player's role
+     * @return The player, seated at the next free seat
+     * @throws GameException if the role is invalid or the table is full
+     */
+    shared_ptr<Player> Game::makePlayer(const string &name, Role role)
+    {
+        // The pointer to the pool shares ownership of the whole arena
+        shared_ptr<pmr::memory_resource> pool(arena_, &arena_->pool);
+        shared_ptr<Player> player;
+        switch (role)
+        {
+        case Role::GENERAL:
+            player = allocate_shared<General>(SharedPoolAllocator<General>(move(pool)), *this, name, role);
+            break;
+        case Role::GOVERNOR:
+            player = allocate_shared<Governor>(SharedPoolAllocator<Governor>(move(pool)), *this, name, role);
+            break;
+        case Role::SPY:
+            player = allocate_shared<Spy>(SharedPoolAllocator<Spy>(move(pool)), *this, name, role);
+            break;
+        case Role::BARON:
+            player = allocate_shared<Baron>(SharedPoolAllocator<Baron>(move(pool)), *this, name, role);
+            break;
+        case Role::JUDGE:
+            player = allocate_shared<Judge>(SharedPoolAllocator<Judge>(move(pool)), *this, name, role);
+            break;
+        case Role::MERCHANT:
+            player = allocate_shared<Merchant>(SharedPoolAllocator<Merchant>(move(pool)), *this, name, role);
+            break;
+        default:
+            throw GameException("Invalid role");
+        }
+        return player;
+    }
+
+    /**
+     * Restarts the game with the same players
+     * Writes the state of a new game back through restore(), which keeps the hash up to date
+     */
+    void Game::reset()
+    {
+        GameState state{};
+        state.playerCount = static_cast<uint8_t>(players_.size());
+        for (size_t seat = 0; seat < players_.size(); ++seat)
+        {
+            state.players[seat] = {0, PlayerState::ACTIVE, NO_ACTION, NO_SEAT, 0};
+        }
+        state.bank = INITIAL_BANK;
+        state.arrestedSeat = NO_SEAT;
+        state.arrestedPlayerSeat = NO_SEAT;
+        state.lastCoupedSeat = NO_SEAT;
+        restore(state);
+
+        journal_.clear();
+    }
+
+    /**
+     * Restarts the game with a roster, keeping the players if the roster is unchanged
+     * @param roles The role of each seat
+     * @param names The name of each seat
+     * @throws GameException if the lists differ in size or createPlayer refuses a player
+     */
+    void Game::reset(const vector<Role> &roles, const vector<string> &names)
+    {
+        if (roles.size() != names.size())
+        {
+            throw GameException("Each seat needs a role and a name");
+        }
 
-        // Loop until we find a unique name
-        while (true)
+        bool same = roles.size() == players_.size();
+        for (size_t seat = 0; same && seat < players_.size(); ++seat)
         {
-            bool name_exists = false;
-            for (const auto &player : players_)
+            same = players_[seat]->role() == roles[seat] && players_[seat]->name() == names[seat];
+        }
+        if (same)
+        {
+            reset();
+            return;
+        }
+
+        // A new roster: drop the players and seat the new ones in an empty game
+        seat_by_name_.clear();
+        players_.clear();
+        auto generation = table_.generation;  // Seats keep counting, so handles to the old players stay stale
+        table_ = PlayerTable{};
+        table_.generation = generation;
+        current_player_index_ = 0;
+        previous_player_index_ = 0;
+        game_started_ = false;
+        has_previous_ = false;
+        arrested_player_seat_ = NO_SEAT;
+        arrested_seat_ = NO_SEAT;
+        last_couped_seat_ = NO_SEAT;
+        bank_balance_ = INITIAL_BANK;
+        journal_.clear();
+        hash_ = computeHash();
+
+        for (size_t seat = 0; seat < roles.size(); ++seat)
+        {
+            createPlayer(names[seat], roles[seat]);
+        }
+    }
+
+    /**
+     * Checks if another game has the same roster
+     * @param other The other game
+     * @return True if both games have the same names and roles in the same seats
+     */
+    bool Game::sameRoster(const Game &other) const
+    {
+        if (players_.size() != other.players_.size() || rules_ != other.rules_)
+        {
+            return false;
+        }
+        for (size_t seat = 0; seat < players_.size(); ++seat)
+        {
+            if (players_[seat]->role() != other.players_[seat]->role() ||
+                players_[seat]->name() != other.players_[seat]->name())
             {
-                if (player->name() == unique_name)
-                {
-                    name_exists = true;
-                    break;
-                }
+                return false;
             }
+        }
+        return true;
+    }
+
+    /**
+     * Lists every action the player may take on their turn, without throwing
+     * @param player The player to generate actions for
+     * @return The legal actions (empty if it is not the player's turn)
+     */
+    LegalActions Game::legalActions(const Player &player) const
+    {
+        LegalActions legal;
+        if (players_.empty() || player.validateTurn() != ActionStatus::OK)
+        {
+            return legal;
+        }
 
-            if (!name_exists)
+        // Actions without a target
+        if (player.validateGather() == ActionStatus::OK)
+        {
+            legal.add({ActionType::GATHER, NO_TARGET});
+        }
+        if (player.validateTax() == ActionStatus::OK)
+        {
+            legal.add({ActionType::TAX, NO_TARGET});
+        }
+        if (player.validateBribe() == ActionStatus::OK)
+        {
+            legal.add({ActionType::BRIBE, NO_TARGET});
+        }
+        if (player.validateInvest() == ActionStatus::OK)
+        {
+            legal.add({ActionType::INVEST, NO_TARGET});
+        }
+
+        // Targeted actions against every other active player, read from the active bitset
+        for (uint32_t seats = table_.active & ~(1u << player.seat()); seats != 0; seats &= seats - 1)
+        {
+            uint8_t targetSeat = static_cast<uint8_t>(__builtin_ctz(seats));
+            const Player &target = *players_[targetSeat];
+            if (player.validateArrest(target) == ActionStatus::OK)
+            {
+                legal.add({ActionType::ARREST, targetSeat});
+            }
+            if (player.validateSanction(target) == ActionStatus::OK)
             {
-                break; // Name is unique, exit loop
+                legal.add({ActionType::SANCTION, targetSeat});
             }
+            if (player.validateCoup(target) == ActionStatus::OK)
+            {
+                legal.add({ActionType::COUP, targetSeat});
+            }
+        }
+        return legal;
+    }
 
-            // Name exists, create a new name with counter
-            counter++;
-            unique_name = name + "_" + to_string(counter);
+    /**
+     * Copies the changing state of one seat into a PlayerState
+     * @param seat The seat index
+     * @param state The state to fill
+     */
+    void Game::savePlayerState(size_t seat, PlayerState &state) const
+    {
+        // Read straight from the player table rather than through the player object
+        state.coins = table_.coins[seat];
+        state.flags = (((table_.active >> seat) & 1u) ? PlayerState::ACTIVE : 0) |
+                      (((table_.blockedEconomic >> seat) & 1u) ? PlayerState::BLOCKED_ECONOMIC : 0) |
+                      (((table_.blockedArrest >> seat) & 1u) ? PlayerState::BLOCKED_ARREST : 0);
+        state.lastAction = table_.lastAction[seat];
+        state.lastTarget = table_.lastTarget[seat];
+        state.reserved = 0;
+    }
+
+    /**
+     * Writes a PlayerState back into one seat
+     * Goes through the player's setters so the hash and active count stay in step
+     * @param seat The seat index
+     * @param state The state to restore
+     */
+    void Game::loadPlayerState(size_t seat, const PlayerState &state)
+    {
+        Player &player = *players_[seat];
+        player.setCoins(state.coins);
+        player.setActive((state.flags & PlayerState::ACTIVE) != 0);
+        player.setBlockedFromEconomic((state.flags & PlayerState::BLOCKED_ECONOMIC) != 0);
+        player.setBlockedFromArresting((state.flags & PlayerState::BLOCKED_ARREST) != 0);
+        player.setLastAction(state.lastAction, state.lastTarget == NO_SEAT ? nullptr : players_[state.lastTarget].get());
+    }
+
+    /**
+     * Gets the GameState::Flag bits of the game
+     * @return STARTED and HAS_PREVIOUS bits
+     */
+    uint8_t Game::stateFlags() const
+    {
+        return (game_started_ ? GameState::STARTED : 0) |
+               (has_previous_ ? GameState::HAS_PREVIOUS : 0);
+    }
+
+    /**
+     * Restores the turn order from saved seats and flags
+     * @param currentSeat Seat whose turn it is
+     * @param previousSeat Seat that played the previous turn
+     * @param flags GameState::Flag bits
+     */
+    void Game::loadTurnOrder(uint8_t currentSeat, uint8_t previousSeat, uint8_t flags)
+    {
+        uint8_t previousBefore = previousSeatCode();
+        rehash(ZobristField::CURRENT_SEAT, current_player_index_, currentSeat);
+        rehash(ZobristField::STARTED, game_started_, (flags & GameState::STARTED) != 0);
+
+        current_player_index_ = currentSeat;
+        previous_player_index_ = previousSeat;
+        game_started_ = (flags & GameState::STARTED) != 0;
+        has_previous_ = (flags & GameState::HAS_PREVIOUS) != 0;
+        rehash(ZobristField::PREVIOUS_SEAT, previousBefore, previousSeatCode());
+    }
+
+    /**
+     * Copies the changing state of the game into a GameState
+     * @param state The snapshot to fill
+     */
+    void Game::snapshot(GameState &state) const
+    {
+        state = GameState{};
+        state.playerCount = static_cast<uint8_t>(players_.size());
+        for (size_t seat = 0; seat < players_.size(); ++seat)
+        {
+            savePlayerState(seat, state.players[seat]);
         }
 
-        // Check we don't exceed the maximum player limit
-        if (players_.size() >= 6)
+        state.bank = bank_balance_;
+        state.currentSeat = static_cast<uint8_t>(current_player_index_);
+        state.previousSeat = static_cast<uint8_t>(previous_player_index_);
+        state.arrestedSeat = arrested_seat_;
+        state.arrestedPlayerSeat = arrested_player_seat_;
+        state.lastCoupedSeat = last_couped_seat_;
+        state.flags = stateFlags();
+    }
+
+    /**
+     * Takes a snapshot of the changing state of the game
+     * @return The snapshot
+     */
+    GameState Game::snapshot() const
+    {
+        GameState state;
+        snapshot(state);
+        return state;
+    }
+
+    /**
+     * Writes a snapshot taken from this game back into it
+     * @param state The snapshot to restore
+     * @throws GameException if the snapshot has a different number of players
+     */
+    void Game::restore(const GameState &state)
+    {
+        if (state.playerCount != players_.size())
         {
-            throw GameException("Maximum number of players (6) reached");
+            throw GameException("Snapshot does not match the players of this game");
         }
 
-        // Create a specific player type based on the role
-        switch (role)
+        for (size_t seat = 0; seat < players_.size(); ++seat)
         {
-        case Role::GENERAL:
+            loadPlayerState(seat, state.players[seat]);
+        }
+
+        bank_balance_ = state.bank;
+        loadTurnOrder(state.currentSeat, state.previousSeat, state.flags);
+
+        setArrestedSeat(state.arrestedSeat);
+        arrested_player_seat_ = state.arrestedPlayerSeat;
+        setLastCoupedSeat(state.lastCoupedSeat);
+    }
+
+    /**
+     * Packs the position (snapshot and roles) into 32 bytes
+     * @param packed Receives the encoding
+     * @return False if the position cannot be packed losslessly
+     */
+    bool Game::pack(PackedState &packed) const
+    {
+        GameState state;
+        snapshot(state);
+        packState(state, table_.roles, packed);
+        return canPack(state);
+    }
+
+    /**
+     * Writes a packed position back into this game
+     * @param packed The encoding
+     * @throws GameException if the encoding does not match this game's seats
+     */
+    void Game::unpack(const PackedState &packed)
+    {
+        GameState state;
+        array<Role, GameState::MAX_PLAYERS> roles;
+        unpackState(packed, state, roles);
+        for (size_t seat = 0; seat < state.playerCount && seat < players_.size(); ++seat)
         {
-            auto player = make_shared<General>(*this, unique_name, role);
-            players_.push_back(player);
-            return player;
+            if (roles[seat] != table_.roles[seat])
+            {
+                throw GameException("Packed position does not match the roles of this game");
+            }
         }
-        case Role::GOVERNOR:
+        restore(state);
+    }
+
+    /**
+     * Records what an action of the current player may change
+     * @param action The action (its target must be a valid seat)
+     * @return The journal entry to push if the action succeeds
+     */
+    Game::JournalEntry Game::journalEntry(const Action &action) const
+    {
+        JournalEntry entry;
+        entry.action = action;
+        entry.actorSeat = static_cast<uint8_t>(current_player_index_);
+        savePlayerState(entry.actorSeat, entry.actor);
+        if (action.hasTarget())
         {
-            auto player = make_shared<Governor>(*this, unique_name, role);
-            players_.push_back(player);
-            return player;
+            savePlayerState(action.target, entry.target);
         }
-        case Role::SPY:
+        entry.bank = bank_balance_;
+        entry.currentSeat = static_cast<uint8_t>(current_player_index_);
+        entry.previousSeat = static_cast<uint8_t>(previous_player_index_);
+        entry.arrestedSeat = arrested_seat_;
+        entry.lastCoupedSeat = last_couped_seat_;
+        entry.flags = stateFlags();
+        return entry;
+    }
+
+    /**
+     * Performs an action for the player whose turn it is and records it in the journal
+     * @param action The action (targets are seat indices)
+     * @return ActionStatus::OK or the rule that forbids the action
+     */
+    ActionStatus Game::apply(const Action &action)
+    {
+        if (players_.empty())
         {
-            auto player = make_shared<Spy>(*this, unique_name, role);
-            players_.push_back(player);
-            return player;
+            return ActionStatus::NOT_YOUR_TURN;
         }
-        case Role::BARON:
+        if (action.hasTarget() && action.target >= players_.size())
         {
-            auto player = make_shared<Baron>(*this, unique_name, role);
-            players_.push_back(player);
-            return player;
+            return ActionStatus::INVALID_TARGET;
         }
-        case Role::JUDGE:
+
+        // Record what the action may change before performing it
+        JournalEntry entry = journalEntry(action);
+
+        shared_ptr<Player> &player = players_[current_player_index_];
+        ActionStatus status = ActionStatus::OK;
+        switch (action.type)
         {
-            auto player = make_shared<Judge>(*this, unique_name, role);
-            players_.push_back(player);
-            return player;
+        case ActionType::GATHER:
+            status = player->tryGather();
+            break;
+        case ActionType::TAX:
+            status = player->tryTax();
+            break;
+        case ActionType::BRIBE:
+            status = player->tryBribe();
+            break;
+        case ActionType::INVEST:
+            status = player->tryInvest();
+            break;
+        case ActionType::ARREST:
+            status = player->tryArrest(*players_[action.target]);
+            break;
+        case ActionType::SANCTION:
+            status = player->trySanction(*players_[action.target]);
+            break;
+        case ActionType::COUP:
+            status = player->tryCoup(*players_[action.target]);
+            break;
         }
-        case Role::MERCHANT:
+
+        if (status == ActionStatus::OK)
         {
-            auto player = make_shared<Merchant>(*this, unique_name, role);
-            players_.push_back(player);
-            return player;
+            journal_.push_back(entry);
         }
-        default:
+        return status;
+    }
+
+    // The rule-table paths of the standard and the configured rules are compiled once, here (see GameStatic.hpp)
+    template ActionStatus Game::applyStatic<DefaultRules>(const Action &action);
+    template LegalActions Game::legalActionsStatic<DefaultRules>() const;
+    template ActionStatus Game::applyStatic<RuleConfig>(const Action &action);
+    template LegalActions Game::legalActionsStatic<RuleConfig>() const;
+
+    /**
+     * Reverts the most recent action recorded by apply()
+     * @return ActionStatus::OK, or NOTHING_TO_UNDO if the journal is empty
+     */
+    ActionStatus Game::undoLast()
+    {
+        if (journal_.empty())
         {
-            throw GameException("Invalid role");
+            return ActionStatus::NOTHING_TO_UNDO;
         }
+        const JournalEntry &entry = journal_.back();
+
+        // Only the two seats the action touched are written back
+        if (entry.action.hasTarget())
+        {
+            loadPlayerState(entry.action.target, entry.target);
         }
+        loadPlayerState(entry.actorSeat, entry.actor);
+
+        bank_balance_ = entry.bank;
+        loadTurnOrder(entry.currentSeat, entry.previousSeat, entry.flags);
+        setArrestedSeat(entry.arrestedSeat);
+        setLastCoupedSeat(entry.lastCoupedSeat);
+
+        journal_.pop_back();
+        return ActionStatus::OK;
     }
 
     /**
@@ -140,12 +599,10 @@ namespace coup
     vector<string> Game::players() const
     {
         vector<string> active_players;
-        for (const auto &player : players_)
+        active_players.reserve(table_.activeCount);
+        for (const auto &player : activePlayers())
         {
-            if (player->isActive())
-            {
-                active_players.push_back(player->name());
-            }
+            active_players.push_back(player->name());
         }
         return active_players;
     }
@@ -157,20 +614,27 @@ namespace coup
      * @throws GameException if no active players are found
      */
     string Game::winner() const
+    {
+        return players_[winnerSeat()]->name();
+    }
+
+    /**
+     * Returns the seat of the winning player
+     * @return The seat of the only active player
+     * @throws GameNotOverException if the game is still in progress
+     * @throws GameException if no active players are found
+     */
+    size_t Game::winnerSeat() const
     {
         if (!isGameOver())
         {
             throw GameNotOverException("Game has not ended yet");
         }
-        for (const auto &player : players_)
+        if (table_.activeCount == 0)
         {
-            if (player->isActive())
-            {
-                return player->name();
-            }
+            throw GameException("No active players found");
         }
-
-        throw GameException("No active players found");
+        return lastSurvivorSeat();
     }
 
     /**
@@ -178,18 +642,9 @@ namespace coup
      * @param player_name The name of the player to remove
      * @throws PlayerNotFound if no player with the given name exists
      */
-    void Game::removePlayer(const string &player_name)
+    void Game::removePlayer(string_view player_name)
     {
-        // Search for the player by name
-        for (auto &player : players_)
-        {
-            if (player->name() == player_name)
-            {
-                player->setActive(false);
-                return;
-            }
-        }
-        throw PlayerNotFound("Player not found: " + player_name);
+        players_[getPlayerIndex(player_name)]->setActive(false);
     }
 
     /**
@@ -209,9 +664,34 @@ namespace coup
         }
     }
 
+    /**
+     * Applies the effects that happen when the turn passes on
+     * Eligibility is checked up front, so a player without income costs no more
+     * than the two flag resets
+     * @param player The player whose turn is ending
+     * @param income The player's turn income (the Merchant's passive income)
+     */
+    void Game::runTurnChangePhase(Player &player, int income)
+    {
+        // Clear any blocks from arresting or economic actions
+        player.setBlockedFromArresting(false);
+        player.setBlockedFromEconomic(false);
+
+        // Pay role income if the player is eligible
+        if (income > 0)
+        {
+            removeCoinsFromBank(income);
+            player.addCoins(income);
+            if (log_hook_)
+            {
+                log_hook_(player.name() + " receives " + to_string(income) + " coin(s) of turn income");
+            }
+        }
+    }
+
     /**
      * Advances the turn to the next active player
-     * Also handles start-of-turn maintenance like clearing blocks and giving Merchant income
+     * Also handles turn-change maintenance like clearing blocks and giving Merchant income
      * @throws GameException if there are no players or not enough players to start
      */
     void Game::advanceTurn()
@@ -221,6 +701,17 @@ namespace coup
             throw GameException("No players in the game");
         }
 
+        // The role class of the player whose turn is ending decides its income
+        passTurn(players_[current_player_index_]->turnIncome());
+    }
+
+    /**
+     * Ends the current turn and moves to the next active player
+     * @param income Turn income of the player whose turn is ending
+     * @throws GameException if there are not enough players to start
+     */
+    void Game::passTurn(int income)
+    {
         // Check there are at least 2 players before starting the game
         if (!game_started_ && players_.size() < 2)
         {
@@ -230,35 +721,27 @@ namespace coup
         // Mark the game as started if this is the first turn
         if (!game_started_)
         {
+            rehash(ZobristField::STARTED, false, true);
             game_started_ = true;
         }
         
-        // Clear any blocks from arresting or economic actions for the current player
-        players_[current_player_index_]->get_blocked_from_arresting() = false;
-        players_[current_player_index_]->setBlockedFromEconomic(false);
-
-        // Handle Merchant's special income ability at the start of their turn
-        try
-        {
-            if (players_[current_player_index_]->role() == Role::MERCHANT)
-            {
-                players_[current_player_index_]->newTurnIncome();
-            }
-        }
-        catch (const InvalidOperation &e)
-        {
-            cerr << e.what() << endl;
-        }
+        // Clear blocks and pay turn income of the player whose turn is ending
+        runTurnChangePhase(*players_[current_player_index_], income);
 
         // Store the current player index before updating
+        uint8_t previousBefore = previousSeatCode();
+        size_t currentBefore = current_player_index_;
         previous_player_index_ = current_player_index_;
-        previous_player_ = players_[previous_player_index_];
+        has_previous_ = true;
 
-        // Find the next active player
+        // Find the next active player in the active bitset
         do
         {
             current_player_index_ = (current_player_index_ + 1) % players_.size();
-        } while (!players_[current_player_index_]->isActive());
+        } while (!((table_.active >> current_player_index_) & 1u));
+
+        rehash(ZobristField::PREVIOUS_SEAT, previousBefore, previous_player_index_);
+        rehash(ZobristField::CURRENT_SEAT, currentBefore, current_player_index_);
     }
 
     /**
@@ -275,22 +758,36 @@ namespace coup
         return players_[current_player_index_];
     }
 
+    /**
+     * Gets the player a handle refers to
+     * @param player The handle
+     * @return The player
+     * @throws PlayerNotFound if the handle is empty or stale
+     */
+    Player &Game::player(PlayerHandle player) const
+    {
+        Player *found = resolve(player);
+        if (!found)
+        {
+            throw PlayerNotFound("Player handle is empty or stale");
+        }
+        return *found;
+    }
+
     /**
      * Gets the index of a player by their name
      * @param name The name of the player to find
      * @return The index of the player in the players vector
      * @throws PlayerNotFound if no player with the given name exists
      */
-    size_t Game::getPlayerIndex(const string &name) const
+    size_t Game::getPlayerIndex(string_view name) const
     {
-        for (size_t i = 0; i < players_.size(); ++i)
+        uint8_t seat = seatOfName(name);
+        if (seat == NO_SEAT)
         {
-            if (players_[i]->name() == name)
-            {
-                return i;
-            }
+            throw PlayerNotFound("Player not found: " + string(name));
         }
-        throw PlayerNotFound("Player not found: " + name);
+        return seat;
     }
 
     /**
@@ -299,32 +796,42 @@ namespace coup
      * @return Shared pointer to the found player
      * @throws PlayerNotFound if no player with the given name exists
      */
-    shared_ptr<Player> Game::getPlayerByName(const string &name) const
+    shared_ptr<Player> Game::getPlayerByName(string_view name) const
     {
-        for (const auto &player : players_)
-        {
-            if (player->name() == name)
-            {
-                return player;
-            }
-        }
-        throw PlayerNotFound("Player not found: " + name);
+        return players_[getPlayerIndex(name)];
     }
     
     /**
-     * Checks if the game is over (only one or fewer active players remain)
-     * @return true if the game is over, false otherwise
+     * Computes the hash contribution of one player's fields
+     * @param player The player
+     * @return XOR of the keys of the player's fields
      */
-    bool Game::isGameOver() const
+    uint64_t Game::playerHash(const Player &player)
     {
-        int active_count = 0;
+        uint8_t seat = player.seat();
+        return zobristKey(ZobristField::COINS, seat, player.coins()) ^
+               zobristKey(ZobristField::ACTIVE, seat, player.isActive()) ^
+               zobristKey(ZobristField::BLOCKED_ECONOMIC, seat, player.blocked_from_economic()) ^
+               zobristKey(ZobristField::BLOCKED_ARREST, seat, player.blocked_from_arresting()) ^
+               zobristKey(ZobristField::LAST_ACTION, seat, player.lastActionCode()) ^
+               zobristKey(ZobristField::LAST_TARGET, seat, player.lastTargetSeat());
+    }
+
+    /**
+     * Computes the hash of the game state from scratch
+     * @return The hash hash() should return
+     */
+    uint64_t Game::computeHash() const
+    {
+        uint64_t hash = zobristKey(ZobristField::CURRENT_SEAT, 0, current_player_index_) ^
+                        zobristKey(ZobristField::PREVIOUS_SEAT, 0, previousSeatCode()) ^
+                        zobristKey(ZobristField::ARRESTED_SEAT, 0, arrested_seat_) ^
+                        zobristKey(ZobristField::LAST_COUPED_SEAT, 0, last_couped_seat_) ^
+                        zobristKey(ZobristField::STARTED, 0, game_started_);
         for (const auto &player : players_)
         {
-            if (player->isActive())
-            {
-                active_count++;
-            }
+            hash ^= playerHash(*player);
         }
-        return active_count <= 1 && game_started_;
+        return hash;
     }
-}
\ No newline at end of file
+}
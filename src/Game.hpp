@@ -4,8 +4,17 @@
 #include <cstddef>       // For size_t
 #include <vector>        // For vector container
 #include <string>        // For string class
+#include <string_view>   // For non-owning names
+#include <unordered_map> // For the name index
 #include <memory>        // For shared_ptr
+#include <memory_resource> // For the per-game arena
+#include <functional>    // For the log hook
 #include "Player.hpp"    // Include Player class
+#include "Action.hpp"    // Include Action and LegalActions
+#include "GameState.hpp" // Include the copyable state snapshot
+#include "PackedState.hpp" // Include the 32-byte position encoding
+#include "Zobrist.hpp"   // Include the position hash keys
+#include "Rules.hpp"     // Include the compile-time rule set
 #include <climits>       // For INT_MAX and other limits
 using namespace std;     // Using standard namespace
 
@@ -14,6 +23,65 @@ namespace coup
     // Forward declaration to resolve circular dependency
     class Player;  // Player class will be defined elsewhere
 
+    /**
+     * Callback that receives the game's event messages (see Game::setLogHook)
+     */
+    using LogHook = function<void(const string &message)>;
+
+    /**
+     * Range over the active players in seat order (see Game::activePlayers)
+     * Walks a copy of the game's active-seat bitmask, so iterating never
+     * allocates and stays valid if players are eliminated meanwhile
+     */
+    class ActivePlayers
+    {
+    public:
+        /**
+         * Iterator over the set bits of the active-seat mask
+         */
+        class iterator
+        {
+        public:
+            iterator(const vector<shared_ptr<Player>> *players, uint32_t seats) : players_(players), seats_(seats) {}
+
+            /**
+             * Gets the seat the iterator points to
+             * @return The seat index
+             */
+            size_t seat() const { return static_cast<size_t>(__builtin_ctz(seats_)); }
+
+            const shared_ptr<Player> &operator*() const { return (*players_)[seat()]; }
+            const shared_ptr<Player> *operator->() const { return &(*players_)[seat()]; }
+            iterator &operator++()
+            {
+                seats_ &= seats_ - 1;  // Clear the lowest set bit
+                return *this;
+            }
+            bool operator==(const iterator &other) const { return seats_ == other.seats_; }
+            bool operator!=(const iterator &other) const { return seats_ != other.seats_; }
+
+        private:
+            const vector<shared_ptr<Player>> *players_;  // The game's players
+            uint32_t seats_;                             // Active seats not visited yet
+        };
+
+        ActivePlayers(const vector<shared_ptr<Player>> &players, uint32_t seats) : players_(&players), seats_(seats) {}
+
+        iterator begin() const { return iterator(players_, seats_); }
+        iterator end() const { return iterator(players_, 0); }
+
+        /**
+         * Gets the number of active players
+         * @return Number of players in the range
+         */
+        size_t size() const { return static_cast<size_t>(__builtin_popcount(seats_)); }
+        bool empty() const { return seats_ == 0; }
+
+    private:
+        const vector<shared_ptr<Player>> *players_;  // The game's players
+        uint32_t seats_;                             // Bit i is set if seat i is active
+    };
+
     /**
      * Game class that manages the Coup game logic
      * Handles player management, turns, and game state
@@ -21,27 +89,214 @@ namespace coup
     class Game
     {
     private:
+        /**
+         * Size of the arena buffer; enough for six players, the name index and a
+         * journal of a few dozen actions before it falls back to the heap
+         */
+        static constexpr size_t ARENA_BYTES = 4096;
+
+        /**
+         * Memory of a game: the arena buffer, the monotonic arena over it and the
+         * pool that recycles players on top of the arena (defined in Game.cpp).
+         * The game and every player's control block share it, so it outlives
+         * both the game and the last pointer to one of its players
+         */
+        struct Arena;
+
+        // Declared first so that it is destroyed after everything allocated from it
+        shared_ptr<Arena> arena_;                      // The game's memory, also held by its players
         vector<shared_ptr<Player>> players_;           // Vector storing all players in the game
         size_t current_player_index_;                  // Index of the current player in the players vector
         size_t previous_player_index_;                 // Index of the previous player in the players vector
         bool game_started_;                            // Flag indicating if the game has started
-        shared_ptr<Player> current_player_;            // Pointer to the current player
-        shared_ptr<Player> previous_player_;           // Pointer to the previous player
-        shared_ptr<Player> arrested_player_;           // Pointer to a player who has been arrested
-        string player_get_arrested;                    // Name of the player who was arrested
-        shared_ptr<Player> last_player_couped;         // Pointer to the last player who was eliminated via coup
+        bool has_previous_;                            // A previous player is recorded in previous_player_index_
+        uint8_t arrested_player_seat_;                 // Seat returned by getArrestedPlayer, or NO_SEAT
+        uint8_t arrested_seat_;                        // Seat of the player who was arrested, or NO_SEAT
+        uint8_t last_couped_seat_;                     // Seat of the last player eliminated via coup, or NO_SEAT
+        pmr::unordered_map<string_view, uint8_t> seat_by_name_; // Seat of each name (views of the players' own names), in the player pool
         int bank_balance_;                             // Total coins in the bank
+        LogHook log_hook_;                             // Receives event messages, empty when logging is disabled
+        uint64_t hash_;                                // Zobrist hash of the state, updated on every change
+        PlayerTable table_;                            // State of every seat; players are handles onto it
+        RuleConfig rules_;                             // Rule values of this game, fixed at construction
+        bool standard_rules_;                          // rules_ holds the values of DefaultRules
+
+        /**
+         * What one applied action may change, recorded before the action so it can be undone:
+         * the acting and target seats, the bank and the turn order
+         */
+        struct JournalEntry
+        {
+            Action action;               // The applied action
+            uint8_t actorSeat;           // Seat of the player who acted
+            PlayerState actor;           // Acting player before the action
+            PlayerState target;          // Target before the action (unused without a target)
+            int32_t bank;                // Bank before the action
+            uint8_t currentSeat;         // Turn order before the action
+            uint8_t previousSeat;
+            uint8_t arrestedSeat;        // Arrested player before the action
+            uint8_t lastCoupedSeat;      // Last couped player before the action
+            uint8_t flags;               // GameState::Flag bits before the action
+        };
+        pmr::vector<JournalEntry> journal_;            // Actions applied with apply(), most recent last
+
+        /**
+         * Applies the effects that happen when the turn passes on: clears the
+         * player's arrest and economic blocks and pays role income that the
+         * player is eligible for. Never throws
+         * @param player The player whose turn is ending
+         */
+        void runTurnChangePhase(Player &player, int income);
+
+        /**
+         * Ends the current turn and moves to the next active player
+         * @param income Turn income of the player whose turn is ending
+         */
+        void passTurn(int income);
+
+        /**
+         * Records what an action of the current player may change
+         * @param action The action (its target must be a valid seat)
+         * @return The journal entry to push if the action succeeds
+         */
+        JournalEntry journalEntry(const Action &action) const;
+
+        /**
+         * Checks an action of the current player against the rule table
+         * Gives the same answer as the players' validate functions
+         * @tparam R The rule set
+         * @param action The action (its target must be a valid seat)
+         * @return ActionStatus::OK or the rule that forbids the action
+         */
+        template <class R>
+        ActionStatus validateStatic(const Action &action) const;
+
+        /**
+         * Performs a validated action of the current player using the rule table
+         * @tparam R The rule set
+         * @param action The action
+         */
+        template <class R>
+        void performStatic(const Action &action);
+
+        /**
+         * Copies the changing state of one seat into a PlayerState
+         * @param seat The seat index
+         * @param state The state to fill
+         */
+        void savePlayerState(size_t seat, PlayerState &state) const;
+
+        /**
+         * Writes a PlayerState back into one seat
+         * @param seat The seat index
+         * @param state The state to restore
+         */
+        void loadPlayerState(size_t seat, const PlayerState &state);
+
+        /**
+         * Gets the GameState::Flag bits of the game
+         * @return STARTED and HAS_PREVIOUS bits
+         */
+        uint8_t stateFlags() const;
+
+        /**
+         * Restores the turn order from saved seats and flags
+         * @param currentSeat Seat whose turn it is
+         * @param previousSeat Seat that played the previous turn
+         * @param flags GameState::Flag bits
+         */
+        void loadTurnOrder(uint8_t currentSeat, uint8_t previousSeat, uint8_t flags);
+
+        /**
+         * Gets the seat that played the previous turn, as stored in the hash
+         * @return The previous seat, or NO_SEAT if no previous player is recorded
+         */
+        uint8_t previousSeatCode() const
+        {
+            return has_previous_ ? static_cast<uint8_t>(previous_player_index_) : NO_SEAT;
+        }
+
+        /**
+         * Updates the hash for one game-wide field
+         * @param field The field that changes
+         * @param before The old value
+         * @param after The new value
+         */
+        void rehash(ZobristField field, int64_t before, int64_t after)
+        {
+            hash_ ^= zobristDelta(field, 0, before, after);
+        }
+
+        /**
+         * Computes the hash contribution of one player's fields
+         * @param player The player
+         * @return XOR of the keys of the player's fields
+         */
+        static uint64_t playerHash(const Player &player);
+
+        /**
+         * Records that a seat became active or inactive (called by Player::setActive)
+         * @param seat The seat
+         * @param active The seat's new state
+         */
+        void updateActiveSeat(uint8_t seat, bool active)
+        {
+            uint32_t bit = 1u << seat;
+            if (active)
+            {
+                table_.active |= bit;
+                table_.activeCount++;
+            }
+            else
+            {
+                table_.active &= ~bit;
+                table_.activeCount--;
+            }
+        }
+
+        /**
+         * Creates a player object of the class that implements a role
+         * @param name The player's name (already unique)
+         * @param role The player's role
+         * @return The player, seated at the next free seat
+         * @throws GameException if the role is invalid or the table is full
+         */
+        shared_ptr<Player> makePlayer(const string &name, Role role);
+
+        /**
+         * Gets the shared pointer of the player a handle refers to (for the pointer-based getters)
+         * @param player The handle
+         * @return The player, or nullptr for the empty or a stale handle
+         */
+        shared_ptr<Player> sharedPlayer(PlayerHandle player) const
+        {
+            return isValid(player) ? players_[player.seat] : nullptr;
+        }
+
+        friend class Player;  // Players report their activation changes
 
     public:
+        /**
+         * Coins in the bank at the start of a game
+         */
+        static constexpr int INITIAL_BANK = 1000000;
+
         /**
          * Constructor - Initializes a new game with default values
+         * @param rules The rule values of the game (default: the standard rules)
+         * @throws GameException if the rule values are not valid
+         */
+        explicit Game(const RuleConfig &rules = RuleConfig());
+
+        /**
+         * Players refer to the game and are allocated from its arena, so a game is neither copied nor moved
          */
-        Game() : current_player_index_(0), previous_player_index_(0), game_started_(false), 
-                current_player_(nullptr), previous_player_(nullptr), arrested_player_(nullptr), 
-                player_get_arrested(""), last_player_couped(nullptr), bank_balance_(1000000) {}
+        Game(const Game &) = delete;
+        Game &operator=(const Game &) = delete;
         
         /**
          * Destructor - Uses default implementation
+         * The arena is released with the game, or with the last pointer to one of its players if that comes later
          */
         ~Game() = default;
 
@@ -51,6 +306,31 @@ namespace coup
          * @return Role enum value of the current player
          */
         Role turn() const;
+
+        /**
+         * Gets the seat whose turn it is
+         * @return The current seat index
+         */
+        uint8_t currentSeat() const { return static_cast<uint8_t>(current_player_index_); }
+
+        /**
+         * Finds the seat of a player by name without throwing
+         * Uses the name index, so the cost does not grow with the number of players
+         * @param name The player's name
+         * @return The seat index, or NO_SEAT if no player has that name
+         */
+        uint8_t seatOfName(string_view name) const
+        {
+            auto it = seat_by_name_.find(name);
+            return it == seat_by_name_.end() ? NO_SEAT : it->second;
+        }
+
+        /**
+         * Gets the name of the player in a seat
+         * @param seat The seat index (must be a seat of this game)
+         * @return View of the player's name, valid as long as the game
+         */
+        string_view playerName(size_t seat) const { return players_[seat]->name(); }
         
         /**
          * Returns a vector of all player names
@@ -66,18 +346,192 @@ namespace coup
 
         /**
          * Creates a new player and adds them to the game
+         * The player is allocated from the game's arena, which the player keeps
+         * alive, so a pointer may be released after the game is destroyed
+         * (the player refers to its game and must not be used by then)
          * @param name The player's name
          * @param role The role the player will play
          * @return Shared pointer to the created player
          */
         shared_ptr<Player> createPlayer(const string &name, const Role &role);
+
+        /**
+         * Restarts the game with the same players
+         * Every seat goes back to the state of a newly created player and the
+         * bank, turn order and journal are cleared, so the game plays exactly
+         * like a new one with the same roster. Players, the name index, the
+         * journal's capacity and the log hook are kept, so this does not allocate
+         */
+        void reset();
+
+        /**
+         * Restarts the game with a roster
+         * If the roster is the one the game already has, the players are kept
+         * and this is the same as reset(); otherwise the players are replaced
+         * as if created with createPlayer in order. Use distinct names, since
+         * createPlayer renames duplicates and a renamed roster never matches
+         * Pointers to replaced players must not be used afterwards. Once the
+         * last pointer to a replaced player is released, its memory goes back
+         * to the game's player pool and the next new player reuses it, so
+         * alternating between rosters does not grow the game's memory
+         * @param roles The role of each seat
+         * @param names The name of each seat
+         * @throws GameException if the lists differ in size or createPlayer refuses a player
+         */
+        void reset(const vector<Role> &roles, const vector<string> &names);
+
+        /**
+         * Checks if another game has the same roster (names and roles in the same seats) and rules
+         * A game with the same roster can take the other's snapshots
+         * @param other The other game
+         * @return True if the rosters and rule values match
+         */
+        bool sameRoster(const Game &other) const;
+
+        /**
+         * Lists every action the player may take on their turn, without throwing
+         * Uses the same rule checks as the action methods, so each listed action
+         * succeeds if it is performed; targets are the other active players
+         * @param player The player to generate actions for
+         * @return The legal actions (empty if it is not the player's turn)
+         */
+        LegalActions legalActions(const Player &player) const;
+
+        /**
+         * Lists the actions of the player whose turn it is using the rule table
+         * Returns the same actions in the same order as legalActions(getPlayer())
+         * without calling the players' virtual functions
+         * @tparam R The rule set (see Rules.hpp); other rule sets list the actions of their variant
+         * @return The legal actions of the current player
+         */
+        template <class R = DefaultRules>
+        LegalActions legalActionsStatic() const;
+
+        /**
+         * Copies the changing state of the game into a GameState
+         * Runs in O(players) and does not allocate
+         * @param state The snapshot to fill
+         */
+        void snapshot(GameState &state) const;
+
+        /**
+         * Takes a snapshot of the changing state of the game
+         * @return The snapshot
+         */
+        GameState snapshot() const;
+
+        /**
+         * Writes a snapshot taken from this game back into it
+         * Runs in O(players); players, names and roles are not part of the
+         * snapshot, so the game must still have the same seats
+         * @param state The snapshot to restore
+         * @throws GameException if the snapshot has a different number of players
+         */
+        void restore(const GameState &state);
+
+        /**
+         * Packs the position (snapshot and roles) into 32 bytes
+         * Equal positions of games with the same roles give equal bytes
+         * @param packed Receives the encoding
+         * @return False if the position cannot be packed losslessly (a seat holds more than PACKED_MAX_COINS)
+         */
+        bool pack(PackedState &packed) const;
+
+        /**
+         * Writes a packed position back into this game
+         * @param packed An encoding made by pack() or packState()
+         * @throws GameException if the encoding's roles or player count differ from this game's seats
+         */
+        void unpack(const PackedState &packed);
+
+        /**
+         * Performs an action for the player whose turn it is and records it in the journal
+         * A refused action changes nothing and is not recorded
+         * @param action The action (targets are seat indices)
+         * @return ActionStatus::OK or the rule that forbids the action
+         */
+        ActionStatus apply(const Action &action);
+
+        /**
+         * Performs an action like apply(), dispatching on the player's Role
+         * through the rule table instead of the role classes' virtual functions
+         * The resulting state, hash and journal are the same as with apply()
+         * @tparam R The rule set (see Rules.hpp); other rule sets play their variant
+         * @param action The action (targets are seat indices)
+         * @return ActionStatus::OK or the rule that forbids the action
+         */
+        template <class R = DefaultRules>
+        ActionStatus applyStatic(const Action &action);
+
+        /**
+         * Performs an action through the rule table under the game's rule values
+         * Uses the folded DefaultRules path when the game plays the standard rules
+         * and the RuleConfig path otherwise; the bot plays through this
+         * @param action The action (targets are seat indices)
+         * @return ActionStatus::OK or the rule that forbids the action
+         */
+        ActionStatus applyRules(const Action &action)
+        {
+            return standard_rules_ ? applyStatic<DefaultRules>(action) : applyStatic<RuleConfig>(action);
+        }
+
+        /**
+         * Lists the actions of the player whose turn it is under the game's rule values
+         * @return The legal actions of the current player
+         */
+        LegalActions legalActionsRules() const
+        {
+            return standard_rules_ ? legalActionsStatic<DefaultRules>() : legalActionsStatic<RuleConfig>();
+        }
+
+        /**
+         * Gets the rule values of the game
+         * @return The RuleConfig the game was constructed with
+         */
+        const RuleConfig &rules() const { return rules_; }
+
+        /**
+         * Reverts the most recent action recorded by apply()
+         * Only the seats and fields the action could change are written back,
+         * so undoing costs about as much as applying
+         * @return ActionStatus::OK, or NOTHING_TO_UNDO if the journal is empty
+         */
+        ActionStatus undoLast();
+
+        /**
+         * Gets the number of actions that can be undone with undoLast()
+         * @return Number of journal entries
+         */
+        size_t journalSize() const { return journal_.size(); }
+
+        /**
+         * Forgets all recorded actions (they can no longer be undone)
+         */
+        void clearJournal() { journal_.clear(); }
+
+        /**
+         * Gets the 64-bit Zobrist hash of the game state
+         * Covers every seat's coins, active and blocked flags, last action and
+         * target, plus the current and previous seat, the arrested and last
+         * couped seats and whether the game has started (not the bank). Kept
+         * up to date in O(1) by every change, so equal positions reached by
+         * different move orders have equal hashes
+         * @return The hash
+         */
+        uint64_t hash() const { return hash_; }
+
+        /**
+         * Computes the hash of the game state from scratch (for verification)
+         * @return The hash hash() should return
+         */
+        uint64_t computeHash() const;
         
         // Helper functions
         /**
          * Removes a player from the game
          * @param player_name Name of the player to remove
          */
-        void removePlayer(const string &player_name);
+        void removePlayer(string_view player_name);
         
         /**
          * Checks if the current player is active
@@ -90,6 +544,19 @@ namespace coup
          */
         void advanceTurn();
 
+        /**
+         * Sets the callback that receives game event messages (e.g. turn income)
+         * Messages are only built while a hook is set
+         * @param hook The callback, or nullptr to disable logging (the default)
+         */
+        void setLogHook(LogHook hook) { log_hook_ = move(hook); }
+
+        /**
+         * Checks whether a log hook is set
+         * @return True if game events are being logged
+         */
+        bool isLoggingEnabled() const { return static_cast<bool>(log_hook_); }
+
         // Getters
         /**
          * Gets the current player
@@ -102,38 +569,113 @@ namespace coup
          * @param name Name of the player to find
          * @return Index of the player in the players vector
          */
-        size_t getPlayerIndex(const string &name) const;
+        size_t getPlayerIndex(string_view name) const;
         
         /**
          * Gets a player by their name
          * @param name Name of the player to find
          * @return Shared pointer to the player
          */
-        shared_ptr<Player> getPlayerByName(const string &name) const;
+        shared_ptr<Player> getPlayerByName(string_view name) const;
         
         /**
          * Gets all players in the game
          * @return Reference to vector of player pointers
          */
         vector<shared_ptr<Player>> &getPlayers() { return players_; };
+
+        /**
+         * Gets all players in the game (read-only)
+         * @return Reference to vector of player pointers
+         */
+        const vector<shared_ptr<Player>> &getPlayers() const { return players_; };
         
         /**
          * Gets the arrested player
-         * @return Reference to shared pointer of arrested player
+         * @return Shared pointer to the arrested player, or nullptr
          */
-        shared_ptr<Player> &getArrestedPlayer() { return arrested_player_; };
+        shared_ptr<Player> getArrestedPlayer() const { return sharedPlayer(arrestedPlayer()); }
+
+        /**
+         * Sets or clears the arrested player
+         * @param player Handle of the arrested player, or the empty handle for none
+         */
+        void setArrestedPlayer(PlayerHandle player) { arrested_player_seat_ = player.seat; }
         
         /**
          * Gets the current player
-         * @return Reference to shared pointer of current player
+         * @return Shared pointer to the current player, or nullptr if there are no players
          */
-        shared_ptr<Player> &getCurrentPlayer() { return current_player_; };
+        shared_ptr<Player> getCurrentPlayer() const { return sharedPlayer(currentPlayer()); }
         
         /**
          * Gets the previous player
-         * @return Reference to shared pointer of previous player
+         * @return Shared pointer to the previous player, or nullptr
          */
-        shared_ptr<Player> &getPreviousPlayer() { return previous_player_; };
+        shared_ptr<Player> getPreviousPlayer() const { return sharedPlayer(previousPlayer()); }
+
+        // Handles - plain values for the engine's bookkeeping and action APIs
+        /**
+         * Gets a handle to the player in a seat
+         * @param seat The seat index
+         * @return The player's handle, or the empty handle if the seat is not taken
+         */
+        PlayerHandle handleOf(size_t seat) const
+        {
+            return seat < players_.size() ? PlayerHandle{static_cast<uint8_t>(seat), table_.generation[seat]} : PlayerHandle();
+        }
+
+        /**
+         * Finds the player a handle refers to
+         * @param player The handle
+         * @return The player, or nullptr for the empty handle or a stale one
+         */
+        Player *resolve(PlayerHandle player) const
+        {
+            return isValid(player) ? players_[player.seat].get() : nullptr;
+        }
+
+        /**
+         * Checks if a handle refers to a current player of this game
+         * @param player The handle
+         * @return False for the empty handle and for handles to replaced players
+         */
+        bool isValid(PlayerHandle player) const
+        {
+            return player.seat < players_.size() && table_.generation[player.seat] == player.generation;
+        }
+
+        /**
+         * Gets the player a handle refers to
+         * @param player The handle
+         * @return The player
+         * @throws PlayerNotFound if the handle is empty or stale
+         */
+        Player &player(PlayerHandle player) const;
+
+        /**
+         * Gets a handle to the player whose turn it is
+         * @return The handle, or the empty handle if there are no players
+         */
+        PlayerHandle currentPlayer() const { return handleOf(current_player_index_); }
+
+        /**
+         * Gets a handle to the player who played the previous turn
+         * @return The handle, or the empty handle if no previous player is recorded
+         */
+        PlayerHandle previousPlayer() const { return has_previous_ ? handleOf(previous_player_index_) : PlayerHandle(); }
+
+        /**
+         * Gets a handle to the arrested player (see getArrestedPlayer)
+         * @return The handle, or the empty handle for none
+         */
+        PlayerHandle arrestedPlayer() const { return handleOf(arrested_player_seat_); }
+
+        /**
+         * Gets a handle to the last player eliminated via coup
+         * @return The handle, or the empty handle for none
+         */
+        PlayerHandle lastCoupedPlayer() const { return handleOf(last_couped_seat_); }
         
         /**
          * Gets the index of the previous player
@@ -148,17 +690,36 @@ namespace coup
         size_t getCurrentPlayerIndex() { return current_player_index_; };
 
         // Methods for handling arrested player
+        /**
+         * Sets the seat of the arrested player
+         * @param seat Seat of the player who was arrested, or NO_SEAT for none
+         */
+        void setArrestedSeat(uint8_t seat)
+        {
+            rehash(ZobristField::ARRESTED_SEAT, arrested_seat_, seat);
+            arrested_seat_ = seat;
+        }
+
+        /**
+         * Gets the seat of the arrested player
+         * @return Seat of the player who was arrested, or NO_SEAT for none
+         */
+        uint8_t arrestedSeat() const { return arrested_seat_; }
+
         /**
          * Sets the name of the arrested player
-         * @param name Name of the player who was arrested
+         * @param name Name of the player who was arrested (an unknown name clears it)
          */
-        void setArrestedPlayerName(const string &name) { player_get_arrested = name; }
+        void setArrestedPlayerName(string_view name) { setArrestedSeat(seatOfName(name)); }
         
         /**
          * Gets the name of the arrested player
-         * @return Name of the arrested player
+         * @return Name of the arrested player, or an empty view for none
          */
-        string getArrestedPlayerName() const { return player_get_arrested; }
+        string_view getArrestedPlayerName() const
+        {
+            return arrested_seat_ == NO_SEAT ? string_view() : playerName(arrested_seat_);
+        }
 
         /**
          * Checks if the game has started correctly
@@ -167,31 +728,89 @@ namespace coup
          */
         bool isGameStarted() const
         {
-            // Check if the game has started and if the number of players is valid (between 2 and 6)
+            // Check if the game has started and if the number of players is valid
             return game_started_ && isValidPlayerCount();
         }
         
         /**
-         * Checks if the game is over
+         * Checks if the game is over (at most one active player is left)
+         * O(1): the active count is kept up to date by every activation change
          * @return True if the game is over, false otherwise
          */
-        bool isGameOver() const;
+        bool isGameOver() const { return table_.activeCount <= 1 && game_started_; }
+
+        /**
+         * Gets the number of players still in the game
+         * @return Number of active players
+         */
+        size_t activeCount() const { return table_.activeCount; }
+
+        /**
+         * Gets the active players in seat order without allocating
+         * @return A range of the active players' shared pointers
+         */
+        ActivePlayers activePlayers() const { return ActivePlayers(players_, table_.active); }
+
+        /**
+         * Gets the active seats as a bitmask
+         * @return Bit i is set if seat i is active
+         */
+        uint32_t activeSeats() const { return table_.active; }
+
+        /**
+         * Gets the seat of the last player left in the game
+         * @return The only active seat, or NO_SEAT unless exactly one player is active
+         */
+        uint8_t lastSurvivorSeat() const
+        {
+            return table_.activeCount == 1 ? static_cast<uint8_t>(__builtin_ctz(table_.active)) : NO_SEAT;
+        }
 
         /**
-         * Checks if the number of players is valid (between 2 and 6)
+         * Gets the seat of the winner
+         * @return The seat of the only active player
+         * @throws GameNotOverException if the game is still in progress
+         * @throws GameException if no active players are found
+         */
+        size_t winnerSeat() const;
+
+        /**
+         * Checks if the number of players is valid (between DefaultRules::MIN_PLAYERS and MAX_PLAYERS)
          * @return True if player count is valid, false otherwise
          */
         bool isValidPlayerCount() const
         {
             size_t player_count = players_.size();
-            return player_count >= 2 && player_count <= 6;
+            return player_count >= DefaultRules::MIN_PLAYERS && player_count <= DefaultRules::MAX_PLAYERS;
+        }
+
+        /**
+         * Gets the seat of the last player who was eliminated via coup
+         * @return The seat, or NO_SEAT if nobody was couped
+         */
+        uint8_t lastCoupedSeat() const { return last_couped_seat_; }
+
+        /**
+         * Sets the seat of the last player who was eliminated via coup
+         * @param seat The couped seat, or NO_SEAT for none
+         */
+        void setLastCoupedSeat(uint8_t seat)
+        {
+            rehash(ZobristField::LAST_COUPED_SEAT, last_couped_seat_, seat);
+            last_couped_seat_ = seat;
         }
 
         /**
          * Gets the last player who was eliminated via coup
-         * @return Reference to shared pointer of the last couped player
+         * @return Shared pointer to the last couped player, or nullptr
          */
-        shared_ptr<Player> &getLastPlayerCouped() { return last_player_couped; }
+        shared_ptr<Player> getLastPlayerCouped() const { return sharedPlayer(lastCoupedPlayer()); }
+
+        /**
+         * Sets the last player who was eliminated via coup
+         * @param player The couped player, or nullptr for none
+         */
+        void setLastPlayerCouped(const shared_ptr<Player> &player) { setLastCoupedSeat(player ? player->seat() : NO_SEAT); }
         
         /**
          * Adds coins to the bank
@@ -205,4 +824,6 @@ namespace coup
          */
         void removeCoinsFromBank(int amount) {bank_balance_ -= amount; }
     };
-}
\ No newline at end of file
+}
+
+#include "GameStatic.hpp"  // Definitions of the rule-table templates
@@ -2,7 +2,8 @@
 /**
  * Header file containing custom exception classes for the Coup game
  * This file defines several exception types that are used throughout the game
- * to handle various error conditions in a structured way
+ * to handle various error conditions in a structured way, and the ActionStatus
+ * codes that report rule violations without throwing
  */
 #pragma once  // Ensures this header file is included only once during compilation
 
@@ -108,4 +109,96 @@ namespace coup
         GameNotOverException(const std::string &message) : GameException(message) {}
     };
 
+    /**
+     * Result of checking a player action against the game rules
+     * Rule checks return one of these codes instead of throwing, so callers
+     * (bots, the simulator, the GUI) can test moves cheaply; the throwing
+     * action methods convert a failed status with throwIfFailed()
+     */
+    enum class ActionStatus
+    {
+        OK,                         // The action is allowed
+        NOT_YOUR_TURN,              // It is not the player's turn
+        PLAYER_INACTIVE,            // The player has been eliminated
+        MUST_COUP,                  // The player holds the forced-coup coin count and must coup
+        BLOCKED_ECONOMIC,           // The player is under economic sanctions
+        BLOCKED_ARREST,             // The player is blocked from arresting
+        ALREADY_ARRESTED,           // The target was the last player arrested
+        NOT_ENOUGH_COINS,           // The player cannot pay for the action
+        NOT_ENOUGH_COINS_TO_BRIBE,  // The player cannot pay for a bribe
+        TARGET_CANNOT_PAY,          // The target does not have the coins the action takes
+        TARGET_INACTIVE,            // The target has been eliminated
+        SELF_TARGET,                // The player targeted themselves
+        INVALID_TARGET,             // The target seat does not exist or its handle is stale
+        NOTHING_TO_UNDO,            // There is no matching action to undo
+        CANNOT_UNDO_OWN,            // The player tried to undo their own action
+        NOT_SUPPORTED               // The player's role does not have this ability
+    };
+
+    /**
+     * Gets the error message that describes a status
+     * @param status The status to describe
+     * @return A human readable message
+     */
+    inline const char *statusMessage(ActionStatus status)
+    {
+        switch (status)
+        {
+        case ActionStatus::OK:
+            return "OK";
+        case ActionStatus::NOT_YOUR_TURN:
+            return "It is not your turn";
+        case ActionStatus::PLAYER_INACTIVE:
+            return "You are not active";
+        case ActionStatus::MUST_COUP:
+            return "Must perform coup when you hold the forced-coup coin count";
+        case ActionStatus::BLOCKED_ECONOMIC:
+            return "You are blocked from economic actions";
+        case ActionStatus::BLOCKED_ARREST:
+            return "You are blocked from arrest actions";
+        case ActionStatus::ALREADY_ARRESTED:
+            return "You cannot arrest the same player twice in a row";
+        case ActionStatus::NOT_ENOUGH_COINS:
+            return "You do not have enough coins to perform this action";
+        case ActionStatus::NOT_ENOUGH_COINS_TO_BRIBE:
+            return "You do not have enough coins to bribe";
+        case ActionStatus::TARGET_CANNOT_PAY:
+            return "Target does not have enough coins";
+        case ActionStatus::TARGET_INACTIVE:
+            return "Cannot target an inactive player";
+        case ActionStatus::SELF_TARGET:
+            return "You cannot target yourself";
+        case ActionStatus::INVALID_TARGET:
+            return "Target player does not exist";
+        case ActionStatus::NOTHING_TO_UNDO:
+            return "There is no action to undo";
+        case ActionStatus::CANNOT_UNDO_OWN:
+            return "You cannot undo your own action";
+        case ActionStatus::NOT_SUPPORTED:
+            return "Player doesn't have this ability";
+        }
+        return "Unknown status";
+    }
+
+    /**
+     * Throws the exception that matches a failed status
+     * @param status The status returned by a rule check
+     * @throws InvalidTurn, NotEnoughCoins or InvalidOperation unless status is OK
+     */
+    inline void throwIfFailed(ActionStatus status)
+    {
+        switch (status)
+        {
+        case ActionStatus::OK:
+            return;
+        case ActionStatus::NOT_YOUR_TURN:
+            throw InvalidTurn(statusMessage(status));
+        case ActionStatus::NOT_ENOUGH_COINS:
+        case ActionStatus::TARGET_CANNOT_PAY:
+            throw NotEnoughCoins(statusMessage(status));
+        default:
+            throw InvalidOperation(statusMessage(status));
+        }
+    }
+
 }
\ No newline at end of file
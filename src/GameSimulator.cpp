@@ -0,0 +1,564 @@
+// orel8155@gmail.com
+/**
+ * @file GameSimulator.cpp
+ * @brief Implementation of the random-policy game simulator
+ */
+
+#include "GameSimulator.hpp"      // Simulator declarations
+#include "GameExceptions.hpp"     // Custom exceptions
+#include <iostream>               // Input/output streams
+#include <algorithm>              // Algorithm utilities
+#include <thread>                 // Thread support
+#include <chrono>                 // Time utilities
+
+namespace coup
+{
+    /**
+     * Converts a Role enum value to its string representation
+     * @param role The Role enum to convert
+     * @return String representation of the role
+     */
+    string role_to_string(Role role)
+    {
+        switch (role)
+        {
+        case Role::GENERAL:
+            return "General";
+        case Role::GOVERNOR:
+            return "Governor";
+        case Role::SPY:
+            return "Spy";
+        case Role::BARON:
+            return "Baron";
+        case Role::JUDGE:
+            return "Judge";
+        case Role::MERCHANT:
+            return "Merchant";
+        default:
+            return "Unknown";
+        }
+    }
+
+    /**
+     * Adds the result of one game to the statistics
+     * @param result The result to record
+     */
+    void SimulationStats::record(const SimulationResult &result)
+    {
+        games++;
+        totalTurns += result.turns;
+        botPlayouts += result.botPlayouts;
+        if (!result.completed)
+        {
+            turnLimit++;
+            return;
+        }
+        completed++;
+        if (result.stalemate)
+        {
+            stalemates++;
+        }
+        if (result.botWon)
+        {
+            botWins++;
+        }
+        winsByRole[static_cast<size_t>(result.winnerRole)]++;
+    }
+
+    /**
+     * Adds the statistics of another batch to this one
+     * @param other The statistics to merge in
+     */
+    void SimulationStats::merge(const SimulationStats &other)
+    {
+        games += other.games;
+        completed += other.completed;
+        stalemates += other.stalemates;
+        turnLimit += other.turnLimit;
+        totalTurns += other.totalTurns;
+        botWins += other.botWins;
+        botPlayouts += other.botPlayouts;
+        for (size_t i = 0; i < ROLE_COUNT; ++i)
+        {
+            winsByRole[i] += other.winsByRole[i];
+        }
+    }
+
+    /**
+     * Constructor for the GameSimulator
+     * @param g Reference to the Game instance
+     * @param players Reference to the vector of Player pointers
+     * @param verbose Whether to output detailed game information
+     * @param seed Seed for the random number generator
+     */
+    GameSimulator::GameSimulator(Game &g, vector<shared_ptr<Player>> &players, bool verbose, uint64_t seed)
+        : game(g), players(players), gen(seed), coupProbability(0.5f), maxTurns(300), verboseMode(verbose),
+          bot(nullptr), botSeats(0), botPlayouts(0) {}
+
+    /**
+     * Prepares the simulator for another game on the same Game object
+     * @param seed Seed for the random number generator
+     * @param stream Stream of the seed (the game's index in its batch)
+     */
+    void GameSimulator::reset(uint64_t seed, uint64_t stream)
+    {
+        gen.seed(seed, stream);
+        coupProbability = 0.5f;
+        botPlayouts = 0;
+    }
+
+    /**
+     * Prints the current game status including turn and player information
+     * Only prints if verbose mode is enabled
+     */
+    void GameSimulator::printGameStatus() const
+    {
+        if (!verboseMode)
+            return;
+
+        cout << "\n=== Game Status ===" << endl;
+        cout << "Current Turn: " << endl;
+        cout << role_to_string(game.turn()) << endl;
+        cout << "Active Players: ";
+        for (const auto &player : game.activePlayers())
+        {
+            cout << player->name() << "(" << player->coins() << " coins) ";
+        }
+        cout << "\n================\n"
+             << endl;
+    }
+
+    /**
+     * Prints information about an action performed by a player
+     * @param playerName Name of the player performing the action
+     * @param action Name of the action being performed
+     * @param target Optional target player of the action
+     * @param success Whether the action was successful
+     */
+    void GameSimulator::printAction(string_view playerName, string_view action, string_view target, bool success) const
+    {
+        if (!verboseMode)
+            return;
+
+        cout << playerName;
+        if (!success)
+            cout << " tried and failed to ";
+        else
+            cout << " performed ";
+        cout << action;
+        if (!target.empty())
+            cout << " on " << target;
+        cout << endl;
+    }
+
+    /**
+     * Selects a random target player for an action
+     * @param currentPlayer The player who is performing the action
+     * @return Handle of the selected target player, or the empty handle if no valid target
+     */
+    PlayerHandle GameSimulator::selectRandomTarget(const Player &currentPlayer)
+    {
+        // Every active player except the current one is a potential target
+        uint32_t targets = game.activeSeats() & ~(1u << currentPlayer.seat());
+        if (targets == 0)
+            return PlayerHandle();
+
+        // Randomly select a target from the remaining players (in seat order)
+        for (uint32_t skip = gen.below(__builtin_popcount(targets)); skip > 0; --skip)
+        {
+            targets &= targets - 1;  // Drop the lowest seat
+        }
+        return game.handleOf(__builtin_ctz(targets));
+    }
+
+    /**
+     * Determines whether a player should attempt a coup action based on probability
+     * @return true if coup should be attempted, false otherwise
+     */
+    bool GameSimulator::shouldAttemptCoup() const
+    {
+        return gen.chance(coupProbability);
+    }
+
+    /**
+     * Determines whether a player should attempt a special action based on probability
+     * @return true if special action should be attempted, false otherwise
+     */
+    bool GameSimulator::shouldAttemptSpecialAction() const
+    {
+        return gen.chance(0.4); // 40% chance for special action
+    }
+
+    /**
+     * Picks one of the legal actions of a type at random
+     * @param legal The legal actions of the current player
+     * @param type The action type (at least one action of it must be legal)
+     * @return The chosen action
+     */
+    Action GameSimulator::randomActionOfType(const LegalActions &legal, ActionType type)
+    {
+        return legal.nth(type, gen.below(static_cast<uint32_t>(legal.count(type))));
+    }
+
+    /**
+     * Executes an action through the non-throwing API and prints the outcome
+     * @param player The player performing the action
+     * @param action The action to perform (from Game::legalActions)
+     * @param note Optional note printed after the action name
+     */
+    void GameSimulator::executeAction(Player &player, const Action &action, const string &note)
+    {
+        string_view targetName = action.hasTarget() ? game.playerName(action.target) : string_view();
+        ActionStatus status = ActionStatus::OK;
+        switch (action.type)
+        {
+        case ActionType::GATHER:
+            status = player.tryGather();
+            break;
+        case ActionType::TAX:
+            status = player.tryTax();
+            break;
+        case ActionType::BRIBE:
+            status = player.tryBribe();
+            break;
+        case ActionType::INVEST:
+            status = player.tryInvest();
+            break;
+        case ActionType::ARREST:
+            status = player.tryArrest(*players[action.target]);
+            break;
+        case ActionType::SANCTION:
+            status = player.trySanction(*players[action.target]);
+            break;
+        case ActionType::COUP:
+            status = player.tryCoup(*players[action.target]);
+            break;
+        }
+        if (verboseMode)
+        {
+            printAction(player.name(), string(actionName(action.type)) + note, targetName, status == ActionStatus::OK);
+        }
+    }
+
+    /**
+     * Executes a special action based on the player's role
+     * Abilities are used through the non-throwing API, a refused ability changes nothing
+     * @param player The player performing the action
+     * @param legal The legal turn actions of the player
+     * @return true if the player's move is done, false if a fallback action should be played
+     */
+    bool GameSimulator::executeSpecialAction(Player &player, const LegalActions &legal)
+    {
+        Role role = player.role();
+
+        if (role == Role::BARON)
+        {
+            if (legal.has(ActionType::INVEST))
+            {
+                executeAction(player, {ActionType::INVEST, NO_TARGET}, " (special)");
+                return true;
+            }
+            return false;
+        }
+
+        Player *target = game.resolve(selectRandomTarget(player));
+        if (!target)
+        {
+            return false;
+        }
+
+        if (role == Role::GOVERNOR)
+        {
+            if (!target->lastActionIs(ActionType::TAX))
+            {
+                return true;
+            }
+            if (player.tryUndo(UndoableAction::TAX) == ActionStatus::OK)
+            {
+                printAction(player.name(), "cancel_taxes (special)", target->name());
+                return true;
+            }
+        }
+        else if (role == Role::JUDGE)
+        {
+            if (!target->lastActionIs(ActionType::BRIBE))
+            {
+                return true;
+            }
+            if (player.tryUndo(UndoableAction::BRIBE) == ActionStatus::OK)
+            {
+                printAction(player.name(), "cancel_bribe (special)", target->name());
+                return true;
+            }
+        }
+        else if (role == Role::GENERAL)
+        {
+            if (player.tryUndo(UndoableAction::COUP) == ActionStatus::OK)
+            {
+                printAction(player.name(), "block_coup (special)", target->name());
+                return true;
+            }
+        }
+        else if (role == Role::SPY)
+        {
+            if (player.tryUndo(UndoableAction::ARREST) == ActionStatus::OK)
+            {
+                printAction(player.name(), "block_arrest (special)", target->name());
+                return true;
+            }
+        }
+
+        // The special action is not available
+        return false;
+    }
+
+    /**
+     * Performs a random turn for the given player based on game state
+     * Moves are drawn from Game::legalActions, so no rule violation is ever thrown
+     * @param player The player whose turn it is
+     */
+    void GameSimulator::performRandomTurn(Player &player)
+    {
+        LegalActions legal = game.legalActions(player);
+        if (legal.empty())
+        {
+            if (verboseMode)
+            {
+                cout << player.name() << " couldn't perform any action!" << endl;
+            }
+            return;
+        }
+
+        // If player is at the forced-coup threshold, they must perform a coup
+        if (player.mustPerformCoup() && legal.has(ActionType::COUP))
+        {
+            executeAction(player, randomActionOfType(legal, ActionType::COUP), " (mandatory)");
+            return;
+        }
+
+        // If player has 7+ coins and randomly decides to coup
+        if (player.coins() >= game.rules().coupCost && legal.has(ActionType::COUP) && shouldAttemptCoup())
+        {
+            executeAction(player, randomActionOfType(legal, ActionType::COUP));
+            return;
+        }
+
+        // Choose a random action type
+        uint32_t actionType = gen.below(3);
+
+        if (actionType == 0)
+        {
+            // Basic actions (gather, tax, bribe)
+            static const ActionType basicActions[] = {ActionType::GATHER, ActionType::TAX, ActionType::BRIBE};
+            ActionType type = basicActions[gen.below(3)];
+            if (legal.has(type))
+            {
+                executeAction(player, {type, NO_TARGET});
+                return;
+            }
+        }
+        else if (actionType == 1)
+        {
+            // Target actions (arrest, sanction, coup)
+            static const ActionType targetActions[] = {ActionType::ARREST, ActionType::SANCTION, ActionType::COUP};
+            ActionType type = targetActions[gen.below(3)];
+            if (legal.has(type))
+            {
+                executeAction(player, randomActionOfType(legal, type));
+                return;
+            }
+        }
+        else if (executeSpecialAction(player, legal))
+        {
+            // Role-specific special action was played
+            return;
+        }
+
+        // Fallback - gather if possible, otherwise any legal action
+        Action fallback = legal.has(ActionType::GATHER) ? Action{ActionType::GATHER, NO_TARGET} : legal[0];
+        executeAction(player, fallback, " (fallback)");
+    }
+
+    /**
+     * Plays the turn chosen by the bot for the given player
+     * @param player The player whose turn it is
+     */
+    void GameSimulator::performBotTurn(Player &player)
+    {
+        LegalActions legal = game.legalActions(player);
+        if (legal.empty())
+        {
+            if (verboseMode)
+            {
+                cout << player.name() << " couldn't perform any action!" << endl;
+            }
+            return;
+        }
+
+        Action action = bot->chooseAction(game);
+        botPlayouts += bot->lastStats().playouts;
+        executeAction(player, action, " (mcts)");
+    }
+
+    /**
+     * Increases the probability that players will attempt coup actions
+     * Used to make games more aggressive as they progress
+     */
+    void GameSimulator::increaseAggression()
+    {
+        coupProbability = min(0.9f, coupProbability + 0.2f);
+        if (verboseMode)
+        {
+            cout << ">>> Increasing aggression! Coup probability raised to " << (coupProbability * 100) << "% <<<" << endl;
+        }
+    }
+
+    /**
+     * Runs a complete game with random AI players
+     * @return The outcome of the game (completed is false if it hit the turn limit)
+     */
+    SimulationResult GameSimulator::runRandomGame()
+    {
+        if (verboseMode)
+        {
+            cout << "\n🎮 Starting random game with " << players.size() << " players!" << endl;
+
+            // Show turn-change events (e.g. Merchant income) alongside the actions
+            game.setLogHook([](const string &message) { cout << "  💰 " << message << endl; });
+        }
+        printGameStatus();
+
+        SimulationResult result;
+        botPlayouts = 0;
+        int currentTurn = 0;
+        uint8_t lastSeat = NO_SEAT;
+        int samePlayerCount = 0;
+
+        while (!game.isGameOver() && currentTurn < maxTurns)
+        {
+            try
+            {
+                uint8_t currentSeat = game.currentSeat();
+                Player &currentPlayer = game.player(game.currentPlayer());
+                const string &currentPlayerName = currentPlayer.name();
+
+                // Check if the same player is getting multiple consecutive turns (potential deadlock)
+                if (currentSeat == lastSeat)
+                {
+                    samePlayerCount++;
+                    if (samePlayerCount >= 15 && game.activeCount() > 1)
+                    {
+                        if (verboseMode)
+                        {
+                            cout << "\n⚠️ Detected stalemate: " << currentPlayerName << " played "
+                                 << samePlayerCount << " consecutive turns!" << endl;
+                        }
+
+                        // Find the player with the most coins to declare as winner
+                        uint8_t winnerSeat = NO_SEAT;
+                        int maxCoins = -1;
+
+                        for (const auto &player : game.activePlayers())
+                        {
+                            if (player->coins() > maxCoins)
+                            {
+                                maxCoins = player->coins();
+                                winnerSeat = player->seat();
+                            }
+                        }
+
+                        // Remove all players except the winner
+                        for (const auto &player : game.activePlayers())
+                        {
+                            if (player->seat() != winnerSeat)
+                            {
+                                player->setActive(false);
+                            }
+                        }
+
+                        if (verboseMode)
+                        {
+                            cout << "👑 " << game.playerName(winnerSeat) << " wins with " << maxCoins << " coins!" << endl;
+                        }
+                        result.stalemate = true;
+                        break;
+                    }
+                }
+                else
+                {
+                    samePlayerCount = 0;
+                    lastSeat = currentSeat;
+                    if (verboseMode)
+                    {
+                        cout << "\n🔄 Switching to player: " << currentPlayerName << endl;
+                    }
+                }
+
+                if (verboseMode)
+                {
+                    cout << "\n--- Turn " << (currentTurn + 1) << ": " << currentPlayerName
+                         << " (" << role_to_string(currentPlayer.role()) << ", " << currentPlayer.coins() << " coins) ---" << endl;
+                }
+
+                if (bot && ((botSeats >> currentSeat) & 1u))
+                {
+                    performBotTurn(currentPlayer);
+                }
+                else
+                {
+                    performRandomTurn(currentPlayer);
+                }
+
+                if (verboseMode && (currentTurn + 1) % 10 == 0)
+                {
+                    printGameStatus();
+                }
+
+                // Increase aggression every 25 turns
+                if ((currentTurn + 1) % 25 == 0)
+                {
+                    increaseAggression();
+                }
+
+                // Short delay for readability
+                if (verboseMode)
+                {
+                    this_thread::sleep_for(chrono::milliseconds(200));
+                }
+            }
+            catch (const GameException &e)
+            {
+                if (verboseMode)
+                {
+                    cout << "Error: " << e.what() << endl;
+                }
+            }
+
+            currentTurn++;
+        }
+
+        result.turns = currentTurn;
+        result.botPlayouts = botPlayouts;
+        if (game.isGameOver())
+        {
+            result.completed = true;
+            result.winnerIndex = game.winnerSeat();
+            const string &winnerName = game.getPlayers()[result.winnerIndex]->name();
+            result.winnerRole = game.getPlayers()[result.winnerIndex]->role();
+            result.botWon = bot && ((botSeats >> result.winnerIndex) & 1u);
+            if (verboseMode)
+            {
+                cout << "\n🏆 Game over! The winner is: " << winnerName << "! 🏆" << endl;
+            }
+            printGameStatus();
+        }
+        else
+        {
+            if (verboseMode)
+            {
+                cout << "\n⏰ Game reached turn limit (" << maxTurns << ")" << endl;
+            }
+        }
+        return result;
+    }
+}
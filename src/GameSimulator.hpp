@@ -0,0 +1,223 @@
+//orel8155@gmail.com
+/**
+ * @file GameSimulator.hpp
+ * @brief Automatic (random policy) play of the Coup game
+ *
+ * The simulator only depends on the game engine (Game, Player and the roles),
+ * so it can be linked into the interactive program as well as into the
+ * headless batch runner without pulling in SFML.
+ */
+#pragma once  // Ensures this header file is included only once during compilation
+
+#include "Game.hpp"      // Core game logic
+#include "Player.hpp"    // Player class definition
+#include "Action.hpp"    // Action and LegalActions
+#include "MctsBot.hpp"   // Search-based bot for some seats
+#include <array>         // Fixed per-role counters
+#include <memory>        // For shared_ptr
+#include "Rng.hpp"       // Random number generation
+#include <random>        // random_device for the default seed
+#include <string>        // For string class
+#include <string_view>   // For names printed without copies
+#include <vector>        // For vector container
+using namespace std;     // Using standard namespace
+
+namespace coup
+{
+    /**
+     * Number of distinct roles in the game (size of per-role tables)
+     */
+    constexpr size_t ROLE_COUNT = 6;
+
+    /**
+     * Converts a Role enum value to its string representation
+     * @param role The Role enum to convert
+     * @return String representation of the role
+     */
+    string role_to_string(Role role);
+
+    /**
+     * Outcome of a single simulated game
+     */
+    struct SimulationResult
+    {
+        bool completed = false;       // True if the game ended with a winner (not by the turn limit)
+        bool stalemate = false;       // True if the winner was declared by stalemate detection
+        int turns = 0;                // Number of simulated turns
+        Role winnerRole = Role::GENERAL; // Role of the winner (valid only if completed)
+        size_t winnerIndex = 0;       // Seat of the winner in the players vector (valid only if completed)
+        bool botWon = false;          // True if the winner's seat was played by the bot
+        size_t botPlayouts = 0;       // Playouts run by the bot during the game
+    };
+
+    /**
+     * Aggregated results of a batch of simulated games
+     */
+    struct SimulationStats
+    {
+        size_t games = 0;                       // Number of games played
+        size_t completed = 0;                   // Games that ended with a winner
+        size_t stalemates = 0;                  // Games decided by stalemate detection
+        size_t turnLimit = 0;                   // Games stopped by the turn limit
+        size_t totalTurns = 0;                  // Sum of turns over all games
+        array<size_t, ROLE_COUNT> winsByRole{}; // Wins counted per role
+        size_t botWins = 0;                     // Games won by a bot seat
+        size_t botPlayouts = 0;                 // Playouts run by the bots
+
+        /**
+         * Adds the result of one game to the statistics
+         * @param result The result to record
+         */
+        void record(const SimulationResult &result);
+
+        /**
+         * Adds the statistics of another batch to this one
+         * @param other The statistics to merge in
+         */
+        void merge(const SimulationStats &other);
+    };
+
+    /**
+     * GameSimulator class - Simulates automatic play of the Coup game
+     * This class provides functionality to run random AI-driven games
+     */
+    class GameSimulator
+    {
+    private:
+        Game &game;                   // Reference to the game instance
+        vector<shared_ptr<Player>> &players;  // Reference to the player list
+        mutable Rng gen;              // Random number generator
+        float coupProbability;        // Probability of attempting a coup action
+        int maxTurns;                 // Maximum number of turns before ending the game
+        bool verboseMode;             // Whether to print detailed game information
+        MctsBot *bot;                 // Bot that plays the bot seats (not owned, may be null)
+        unsigned int botSeats;        // Bit i is set if seat i is played by the bot
+        size_t botPlayouts;           // Playouts run by the bot in the current game
+
+    public:
+        /**
+         * Constructor for the GameSimulator
+         * @param g Reference to the Game instance
+         * @param players Reference to the vector of Player pointers
+         * @param verbose Whether to output detailed game information (default: true)
+         * @param seed Seed for the random number generator (default: random_device)
+         */
+        GameSimulator(Game &g, vector<shared_ptr<Player>> &players, bool verbose = true,
+                      uint64_t seed = random_device{}());
+
+        /**
+         * Prints the current game status including turn and player information
+         * Only prints if verbose mode is enabled
+         */
+        void printGameStatus() const;
+
+        /**
+         * Prints information about an action performed by a player
+         * @param playerName Name of the player performing the action
+         * @param action Name of the action being performed
+         * @param target Optional target player of the action
+         * @param success Whether the action was successful
+         */
+        void printAction(string_view playerName, string_view action, string_view target = {}, bool success = true) const;
+
+        /**
+         * Selects a random target player for an action
+         * @param currentPlayer The player who is performing the action
+         * @return Handle of the selected target player, or the empty handle if no valid target
+         */
+        PlayerHandle selectRandomTarget(const Player &currentPlayer);
+
+        /**
+         * Determines whether a player should attempt a coup action based on probability
+         * @return true if coup should be attempted, false otherwise
+         */
+        bool shouldAttemptCoup() const;
+
+        /**
+         * Determines whether a player should attempt a special action based on probability
+         * @return true if special action should be attempted, false otherwise
+         */
+        bool shouldAttemptSpecialAction() const;
+
+        /**
+         * Picks one of the legal actions of a type at random
+         * @param legal The legal actions of the current player
+         * @param type The action type (at least one action of it must be legal)
+         * @return The chosen action
+         */
+        Action randomActionOfType(const LegalActions &legal, ActionType type);
+
+        /**
+         * Executes an action through the non-throwing API and prints the outcome
+         * @param player The player performing the action
+         * @param action The action to perform (from Game::legalActions)
+         * @param note Optional note printed after the action name
+         */
+        void executeAction(Player &player, const Action &action, const string &note = "");
+
+        /**
+         * Executes a special action based on the player's role
+         * @param player The player performing the action
+         * @param legal The legal turn actions of the player
+         * @return true if the player's move is done, false if a fallback action should be played
+         */
+        bool executeSpecialAction(Player &player, const LegalActions &legal);
+
+        /**
+         * Performs a random turn for the given player based on game state
+         * @param player The player whose turn it is
+         */
+        void performRandomTurn(Player &player);
+
+        /**
+         * Plays the turn chosen by the bot for the given player
+         * @param player The player whose turn it is
+         */
+        void performBotTurn(Player &player);
+
+        /**
+         * Lets a bot play some of the seats; the other seats keep the random policy
+         * @param mctsBot The bot (must outlive the simulator), or nullptr for none
+         * @param seatMask Bit i set means seat i is played by the bot
+         */
+        void setBot(MctsBot *mctsBot, unsigned int seatMask)
+        {
+            bot = mctsBot;
+            botSeats = seatMask;
+        }
+
+        /**
+         * Increases the probability that players will attempt coup actions
+         * Used to make games more aggressive as they progress
+         */
+        void increaseAggression();
+
+        /**
+         * Runs a complete game with random AI players
+         * @return The outcome of the game (completed is false if it hit the turn limit)
+         */
+        SimulationResult runRandomGame();
+
+        /**
+         * Sets the verbose mode for the simulator
+         * @param verbose true for detailed output, false for minimal output
+         */
+        void setVerbose(bool verbose) { verboseMode = verbose; }
+
+        /**
+         * Sets the maximum number of turns before a game is stopped
+         * @param turns The turn limit
+         */
+        void setMaxTurns(int turns) { maxTurns = turns; }
+
+        /**
+         * Prepares the simulator for another game on the same Game object
+         * Reseeds the random number generator and clears what the previous game
+         * changed; verbose mode, the turn limit and the bot are kept. The game
+         * itself is reset separately with Game::reset
+         * @param seed Seed for the random number generator
+         * @param stream Stream of the seed (the game's index in its batch)
+         */
+        void reset(uint64_t seed, uint64_t stream = 0);
+    };
+}
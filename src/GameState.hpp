@@ -0,0 +1,87 @@
+//orel8155@gmail.com
+/**
+ * @file GameState.hpp
+ * @brief Plain, trivially copyable snapshot of everything that changes during a game
+ *
+ * Players and the game hold references to each other, so a Game cannot be
+ * copied. A GameState holds the same information by value, with players and
+ * targets stored as seat indices, so it can be copied with memcpy, kept on
+ * the stack of a search and written back with Game::restore.
+ */
+#pragma once  // Ensures this header file is included only once during compilation
+
+#include <cstddef>      // For size_t
+#include <cstdint>      // For fixed-width integers
+#include <type_traits>  // For is_trivially_copyable
+
+namespace coup
+{
+    /**
+     * Seat value meaning "no player"
+     */
+    constexpr uint8_t NO_SEAT = 0xFF;
+
+    /**
+     * Last-action value of a player who has not acted yet
+     * (other values are ActionType codes)
+     */
+    constexpr uint8_t NO_ACTION = 0xFF;
+
+    /**
+     * @struct PlayerState
+     * @brief The changing part of one player
+     */
+    struct PlayerState
+    {
+        /**
+         * Bits of the flags field
+         */
+        enum Flag : uint8_t
+        {
+            ACTIVE = 1 << 0,            // Player is still in the game
+            BLOCKED_ECONOMIC = 1 << 1,  // Player is blocked from gather and tax
+            BLOCKED_ARREST = 1 << 2     // Player is blocked from arresting
+        };
+
+        int32_t coins;        // Player's coin count
+        uint8_t flags;        // Combination of Flag bits
+        uint8_t lastAction;   // ActionType of the player's last action, or NO_ACTION
+        uint8_t lastTarget;   // Seat of the last action's target, or NO_SEAT
+        uint8_t reserved;     // Padding, always 0
+    };
+
+    /**
+     * @struct GameState
+     * @brief The changing part of a game (players' state, bank and turn order)
+     */
+    struct GameState
+    {
+        /**
+         * Maximum number of players in a game
+         */
+        static constexpr size_t MAX_PLAYERS = 6;
+
+        /**
+         * Bits of the flags field
+         */
+        enum Flag : uint8_t
+        {
+            STARTED = 1 << 0,       // The first turn has been played
+            HAS_PREVIOUS = 1 << 1   // A previous player is recorded
+        };
+
+        PlayerState players[MAX_PLAYERS];  // State of each seat (only the first playerCount are used)
+        int32_t bank;                      // Coins in the bank
+        uint8_t playerCount;               // Number of seats in the game
+        uint8_t currentSeat;               // Seat whose turn it is
+        uint8_t previousSeat;              // Seat that played the previous turn
+        uint8_t arrestedSeat;              // Seat of the last arrested player, or NO_SEAT
+        uint8_t arrestedPlayerSeat;        // Seat held by Game::getArrestedPlayer, or NO_SEAT
+        uint8_t lastCoupedSeat;            // Seat of the last player eliminated by a coup, or NO_SEAT
+        uint8_t flags;                     // Combination of Flag bits
+        uint8_t reserved;                  // Padding, always 0
+    };
+
+    static_assert(std::is_trivially_copyable<GameState>::value, "GameState must be copyable with memcpy");
+    static_assert(sizeof(GameState) <= 64, "GameState should fit in one cache line");
+}
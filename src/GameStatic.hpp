@@ -0,0 +1,277 @@
+//orel8155@gmail.com
+/**
+ * @file GameStatic.hpp
+ * @brief Template definitions of Game's rule-table path (included by Game.hpp)
+ *
+ * The rule-table path is a template over the rule set (see Rules.hpp), so its
+ * definitions live in a header. The values are read through RuleView, which
+ * folds a compile-time rule set into constants and reads the game's
+ * RuleConfig for R = RuleConfig. DefaultRules and RuleConfig are instantiated
+ * once in Game.cpp; other rule sets are instantiated where they are used.
+ */
+#pragma once  // Ensures this header file is included only once during compilation
+
+#include "Game.hpp"  // The class whose members are defined here
+
+namespace coup
+{
+    /**
+     * Performs an action like apply(), dispatching on the player's Role through the rule table
+     * @param action The action (targets are seat indices)
+     * @return ActionStatus::OK or the rule that forbids the action
+     */
+    template <class R>
+    ActionStatus Game::applyStatic(const Action &action)
+    {
+        if (players_.empty())
+        {
+            return ActionStatus::NOT_YOUR_TURN;
+        }
+        if (action.hasTarget() && action.target >= players_.size())
+        {
+            return ActionStatus::INVALID_TARGET;
+        }
+
+        ActionStatus status = validateStatic<R>(action);
+        if (status != ActionStatus::OK)
+        {
+            return status;
+        }
+
+        JournalEntry entry = journalEntry(action);
+        performStatic<R>(action);
+        journal_.push_back(entry);
+        return ActionStatus::OK;
+    }
+
+    /**
+     * Checks an action of the current player against the rule table
+     * The checks and their order mirror Player::validateX and the role overrides
+     * @param action The action (its target must be a valid seat)
+     * @return ActionStatus::OK or the rule that forbids the action
+     */
+    template <class R>
+    ActionStatus Game::validateStatic(const Action &action) const
+    {
+        RuleView<R> config(rules_);
+        size_t actor = current_player_index_;
+        const RoleRules &rules = config.role(table_.roles[actor]);
+        int coins = table_.coins[actor];
+        bool blockedEconomic = (table_.blockedEconomic >> actor) & 1u;
+
+        switch (action.type)
+        {
+        case ActionType::TAX:
+            if (rules.taxChecksBlockFirst)
+            {
+                if (blockedEconomic)
+                {
+                    return ActionStatus::BLOCKED_ECONOMIC;
+                }
+                return coins >= config.mustCoupCoins() ? ActionStatus::MUST_COUP : ActionStatus::OK;
+            }
+            [[fallthrough]];
+        case ActionType::GATHER:
+            if (coins >= config.mustCoupCoins())
+            {
+                return ActionStatus::MUST_COUP;
+            }
+            if (!((table_.active >> actor) & 1u))
+            {
+                return ActionStatus::PLAYER_INACTIVE;
+            }
+            return blockedEconomic ? ActionStatus::BLOCKED_ECONOMIC : ActionStatus::OK;
+        case ActionType::BRIBE:
+            if (coins >= config.mustCoupCoins())
+            {
+                return ActionStatus::MUST_COUP;
+            }
+            return coins < config.bribeCost() ? ActionStatus::NOT_ENOUGH_COINS_TO_BRIBE : ActionStatus::OK;
+        case ActionType::INVEST:
+            if (!rules.canInvest)
+            {
+                return ActionStatus::NOT_SUPPORTED;
+            }
+            return coins < config.investCost() ? ActionStatus::NOT_ENOUGH_COINS : ActionStatus::OK;
+        case ActionType::ARREST:
+        {
+            if ((table_.blockedArrest >> actor) & 1u)
+            {
+                return ActionStatus::BLOCKED_ARREST;
+            }
+            if (arrested_seat_ == action.target)
+            {
+                return ActionStatus::ALREADY_ARRESTED;
+            }
+            if (coins >= config.mustCoupCoins())
+            {
+                return ActionStatus::MUST_COUP;
+            }
+            bool takesCoin = config.role(table_.roles[action.target]).arrestTakesCoin;
+            return takesCoin && table_.coins[action.target] < 1 ? ActionStatus::TARGET_CANNOT_PAY : ActionStatus::OK;
+        }
+        case ActionType::SANCTION:
+        {
+            if (coins >= config.mustCoupCoins())
+            {
+                return ActionStatus::MUST_COUP;
+            }
+            int cost = config.sanctionCost() + config.role(table_.roles[action.target]).sanctionPenalty;
+            return coins < cost ? ActionStatus::NOT_ENOUGH_COINS : ActionStatus::OK;
+        }
+        case ActionType::COUP:
+            if (coins < config.coupCost())
+            {
+                return ActionStatus::NOT_ENOUGH_COINS;
+            }
+            if (!((table_.active >> action.target) & 1u))
+            {
+                return ActionStatus::TARGET_INACTIVE;
+            }
+            return action.target == actor ? ActionStatus::SELF_TARGET : ActionStatus::OK;
+        }
+        return ActionStatus::NOT_SUPPORTED;
+    }
+
+    /**
+     * Performs a validated action of the current player using the rule table
+     * The effects mirror Player::tryX and the role overrides; the order of the
+     * writes may differ, but the resulting state and hash are the same
+     * @param action The action
+     */
+    template <class R>
+    void Game::performStatic(const Action &action)
+    {
+        RuleView<R> config(rules_);
+        size_t actorSeat = current_player_index_;
+        Player &actor = *players_[actorSeat];
+        Role role = table_.roles[actorSeat];
+        const RoleRules &rules = config.role(role);
+
+        switch (action.type)
+        {
+        case ActionType::GATHER:
+            actor.addCoins(1);
+            actor.recordAction(ActionType::GATHER);
+            break;
+        case ActionType::TAX:
+            removeCoinsFromBank(rules.taxBankCost);
+            actor.addCoins(rules.taxGain);
+            actor.recordAction(ActionType::TAX);
+            break;
+        case ActionType::BRIBE:
+            actor.removeCoins(config.bribeCost());
+            actor.recordAction(ActionType::BRIBE);
+            actor.setBlockedFromEconomic(false);
+            return;  // The briber keeps the turn
+        case ActionType::INVEST:
+            actor.setCoins(actor.coins() - config.investCost() + config.investReturn());
+            actor.recordAction(ActionType::INVEST);
+            break;
+        case ActionType::ARREST:
+        {
+            Player &target = *players_[action.target];
+            const RoleRules &targetRules = config.role(target.role());
+            actor.recordAction(ActionType::ARREST, &target);
+            setArrestedSeat(action.target);
+            if (targetRules.arrestTakesCoin)
+            {
+                target.removeCoins(1);
+                actor.addCoins(1);
+            }
+            if (targetRules.arrestBankFee > 0 && target.coins() >= targetRules.arrestBankFee)
+            {
+                target.removeCoins(targetRules.arrestBankFee);
+                addCoinsToBank(targetRules.arrestBankFee);
+            }
+            break;
+        }
+        case ActionType::SANCTION:
+        {
+            Player &target = *players_[action.target];
+            const RoleRules &targetRules = config.role(target.role());
+            int cost = config.sanctionCost() + targetRules.sanctionPenalty;
+            actor.removeCoins(cost);
+            addCoinsToBank(cost);
+            actor.recordAction(ActionType::SANCTION, &target);
+            target.setBlockedFromEconomic(true);
+            if (targetRules.sanctionRefund > 0)
+            {
+                target.addCoins(targetRules.sanctionRefund);
+            }
+            break;
+        }
+        case ActionType::COUP:
+            actor.removeCoins(config.coupCost());
+            players_[action.target]->setActive(false);
+            actor.recordAction(ActionType::COUP, players_[action.target].get());
+            setLastCoupedSeat(action.target);
+            break;
+        }
+
+        passTurn(actor.coins() > config.role(role).incomeAbove ? 1 : 0);
+    }
+
+    /**
+     * Lists the actions of the player whose turn it is using the rule table
+     * @return The legal actions of the current player, in the order of legalActions()
+     */
+    template <class R>
+    LegalActions Game::legalActionsStatic() const
+    {
+        RuleView<R> config(rules_);
+        LegalActions legal;
+        if (players_.empty() || !((table_.active >> current_player_index_) & 1u))
+        {
+            return legal;
+        }
+
+        // The rules of validateStatic, with the actor's part worked out once for the whole list
+        size_t actor = current_player_index_;
+        int coins = table_.coins[actor];
+        bool mustCoup = coins >= config.mustCoupCoins();
+        if (!mustCoup)
+        {
+            if (!((table_.blockedEconomic >> actor) & 1u))
+            {
+                legal.add({ActionType::GATHER, NO_TARGET});
+                legal.add({ActionType::TAX, NO_TARGET});
+            }
+            if (coins >= config.bribeCost())
+            {
+                legal.add({ActionType::BRIBE, NO_TARGET});
+            }
+        }
+        if (config.role(table_.roles[actor]).canInvest && coins >= config.investCost())  // Investing is allowed when a coup is due
+        {
+            legal.add({ActionType::INVEST, NO_TARGET});
+        }
+
+        // Targeted actions against every other active player
+        bool canArrest = !mustCoup && !((table_.blockedArrest >> actor) & 1u);
+        for (uint32_t seats = table_.active & ~(1u << actor); seats != 0; seats &= seats - 1)
+        {
+            uint8_t targetSeat = static_cast<uint8_t>(__builtin_ctz(seats));
+            const RoleRules &targetRules = config.role(table_.roles[targetSeat]);
+            if (canArrest && arrested_seat_ != targetSeat &&
+                !(targetRules.arrestTakesCoin && table_.coins[targetSeat] < 1))
+            {
+                legal.add({ActionType::ARREST, targetSeat});
+            }
+            if (!mustCoup && coins >= config.sanctionCost() + targetRules.sanctionPenalty)
+            {
+                legal.add({ActionType::SANCTION, targetSeat});
+            }
+            if (coins >= config.coupCost())
+            {
+                legal.add({ActionType::COUP, targetSeat});
+            }
+        }
+        return legal;
+    }
+
+    extern template ActionStatus Game::applyStatic<DefaultRules>(const Action &action);
+    extern template LegalActions Game::legalActionsStatic<DefaultRules>() const;
+    extern template ActionStatus Game::applyStatic<RuleConfig>(const Action &action);
+    extern template LegalActions Game::legalActionsStatic<RuleConfig>() const;
+}
@@ -0,0 +1,518 @@
+//orel8155@gmail.com
+/**
+ * @file MctsBot.cpp
+ * @brief Implementation of the Monte Carlo Tree Search player
+ */
+
+#include "MctsBot.hpp"          // Bot declarations
+#include "Player.hpp"           // Player class definition
+#include "GameExceptions.hpp"   // Custom exceptions
+#include <algorithm>            // For max and swap
+#include <cmath>                // sqrt, log and llround
+#include <thread>               // Search threads
+
+namespace coup
+{
+    namespace
+    {
+        /**
+         * Gets the transposition table key of a node
+         * The same position is scored for the seat that moved into it, so the mover is part of the key
+         * @param game The game, in the node's position
+         * @param mover Seat that played the node's move
+         * @return The key
+         */
+        uint64_t tableKey(const Game &game, uint8_t mover)
+        {
+            return game.hash() ^ zobristKey(ZobristField::CURRENT_SEAT, mover, -1);
+        }
+
+        /**
+         * Builds a game with the same seats and rules as another and copies its state
+         * Players hold a reference to their game, so a search thread cannot share the caller's game
+         * @param game The game to copy
+         * @return The copy
+         */
+        unique_ptr<Game> copyGame(const Game &game)
+        {
+            auto copy = make_unique<Game>(game.rules());
+            for (const auto &player : game.getPlayers())
+            {
+                copy->createPlayer(player->name(), player->role());
+            }
+            copy->restore(game.snapshot());
+            return copy;
+        }
+    }
+
+    /**
+     * Constructor for the MCTS bot
+     * @param config Search budget and parameters
+     */
+    MctsBot::MctsBot(const MctsConfig &config) : config_(config), searches_(0)
+    {
+        // A search needs at least one budget and one thread
+        if (config_.maxPlayouts == 0 && config_.maxMillis <= 0)
+        {
+            config_.maxPlayouts = MctsConfig().maxPlayouts;
+        }
+        config_.threads = max(config_.threads, 1u);
+    }
+
+    /**
+     * Destructor - frees the search trees
+     */
+    MctsBot::~MctsBot() = default;
+
+    /**
+     * Makes sure a tree exists and can hold a number of nodes, then empties it
+     * @param index The tree index
+     * @param capacity The number of nodes needed
+     * @return The empty tree
+     */
+    MctsBot::Tree &MctsBot::prepareTree(size_t index, size_t capacity)
+    {
+        while (trees_.size() <= index)
+        {
+            trees_.push_back(make_unique<Tree>());
+        }
+
+        Tree &tree = *trees_[index];
+        if (tree.capacity < capacity)
+        {
+            tree.nodes.reset(new Node[capacity]);
+            tree.capacity = capacity;
+        }
+        tree.size.store(0);
+        tree.limit = 0;
+        tree.claimed.store(0);
+        return tree;
+    }
+
+    /**
+     * Takes a free node from a tree's pool and clears it
+     * @param tree The tree
+     * @return The node index, or NONE if the pool is full
+     */
+    uint32_t MctsBot::allocateNode(Tree &tree)
+    {
+        uint32_t index = tree.size.fetch_add(1, memory_order_relaxed);
+        if (index >= tree.capacity)
+        {
+            tree.size.store(static_cast<uint32_t>(tree.capacity), memory_order_relaxed);
+            return NONE;
+        }
+
+        Node &n = tree.nodes[index];
+        n.move = Action();
+        n.mover = NO_SEAT;
+        n.untriedCount = 0;
+        n.nextUntried.store(0, memory_order_relaxed);
+        n.parent = 0;
+        n.firstChild.store(NONE, memory_order_relaxed);
+        n.nextSibling = NONE;
+        n.visits.store(0, memory_order_relaxed);
+        n.reward.store(0, memory_order_relaxed);
+        n.key = 0;
+        return index;
+    }
+
+    /**
+     * Lists the untried actions of a node from the current position, in random order
+     * Threads claim untried actions front to back, so the shuffle makes each expansion random
+     * @param worker The thread, with its game in the node's position
+     * @param node The node
+     */
+    void MctsBot::listActions(Worker &worker, Node &node)
+    {
+        Game &game = *worker.game;
+        node.untriedCount = 0;
+        if (game.isGameOver())
+        {
+            return;
+        }
+
+        LegalActions legal = game.legalActionsRules();
+        for (const Action &action : legal)
+        {
+            node.untried[node.untriedCount++] = action;
+        }
+        for (uint32_t i = node.untriedCount; i > 1; --i)  // Fisher-Yates shuffle
+        {
+            swap(node.untried[i - 1], node.untried[worker.gen.below(i)]);
+        }
+    }
+
+    /**
+     * Picks the published child with the highest UCT value
+     * @param tree The tree
+     * @param node The node index
+     * @return The chosen child index, or NONE if no child is published yet
+     */
+    uint32_t MctsBot::selectChild(const Tree &tree, uint32_t node) const
+    {
+        double logVisits = log(static_cast<double>(tree.nodes[node].visits.load(memory_order_relaxed)));
+        uint32_t best = NONE;
+        double bestValue = -1;
+        for (uint32_t child = tree.nodes[node].firstChild.load(memory_order_acquire); child != NONE;
+             child = tree.nodes[child].nextSibling)
+        {
+            // Published children have at least one visit; virtual losses lower the mean until the reward arrives
+            const Node &c = tree.nodes[child];
+            double visits = c.visits.load(memory_order_relaxed);
+            double mean = c.reward.load(memory_order_relaxed) / REWARD_SCALE / visits;
+
+            // A transposition seen more often than this node gives a better estimate of the position
+            TTData entry;
+            if (config_.table && config_.table->probe(c.key, entry) && entry.visits > visits)
+            {
+                mean = entry.value;
+            }
+            double value = mean + config_.exploration * sqrt(logVisits / visits);
+            if (value > bestValue)
+            {
+                bestValue = value;
+                best = child;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * Plays a claimed untried action of a node and publishes its child
+     * @param tree The tree
+     * @param worker The thread, with its game in the node's position
+     * @param node The node index
+     * @param action The claimed action
+     * @return The new child index, or NONE (with the game unchanged) if the pool is full
+     */
+    uint32_t MctsBot::expand(Tree &tree, Worker &worker, uint32_t node, Action action) const
+    {
+        // Take the node before playing the move, so a full pool leaves the game in the node's position
+        uint32_t index = allocateNode(tree);
+        if (index == NONE)
+        {
+            return NONE;
+        }
+
+        Game &game = *worker.game;
+        uint8_t mover = static_cast<uint8_t>(game.getCurrentPlayerIndex());
+        game.applyRules(action);
+
+        // Fill in the child before other threads can see it; its first visit is this playout's virtual loss
+        Node &child = tree.nodes[index];
+        child.move = action;
+        child.mover = mover;
+        child.parent = node;
+        child.visits.store(1, memory_order_relaxed);
+        child.key = config_.table ? tableKey(game, mover) : 0;
+        listActions(worker, child);
+
+        // Push it onto the parent's child list
+        atomic<uint32_t> &head = tree.nodes[node].firstChild;
+        uint32_t first = head.load(memory_order_relaxed);
+        do
+        {
+            child.nextSibling = first;
+        } while (!head.compare_exchange_weak(first, index, memory_order_release, memory_order_relaxed));
+        return index;
+    }
+
+    /**
+     * Plays random actions until the game ends or the depth limit
+     * @param worker The thread, with its game in the leaf's position
+     */
+    void MctsBot::rollout(Worker &worker) const
+    {
+        Game &game = *worker.game;
+        for (int depth = 0; depth < config_.maxRolloutDepth && !game.isGameOver(); ++depth)
+        {
+            LegalActions legal = game.legalActionsRules();
+            if (legal.empty())
+            {
+                break;
+            }
+            game.applyRules(legal[worker.gen.below(static_cast<uint32_t>(legal.size()))]);
+            worker.rolloutMoves++;
+        }
+    }
+
+    /**
+     * Scores the current position for every seat
+     * @param game The game at the end of a rollout
+     * @param reward Reward of each seat
+     */
+    void MctsBot::score(const Game &game, double reward[GameState::MAX_PLAYERS]) const
+    {
+        size_t active = game.activeCount();
+        uint32_t seats = game.activeSeats();
+        for (size_t seat = 0; seat < GameState::MAX_PLAYERS; ++seat)
+        {
+            bool alive = (seats >> seat) & 1u;
+            reward[seat] = alive ? 1.0 / active : 0.0;
+        }
+    }
+
+    /**
+     * Adds one playout's reward to a node's transposition table entry
+     * Concurrent updates of one entry may lose a playout; the table trades that for having no locks
+     * @param key The node's table key
+     * @param reward The reward of the node's mover
+     */
+    void MctsBot::updateTable(uint64_t key, double reward) const
+    {
+        TTData entry;
+        if (!config_.table->probe(key, entry))
+        {
+            entry = TTData();
+        }
+        entry.value = static_cast<float>((entry.value * entry.visits + reward) / (entry.visits + 1.0));
+        entry.visits++;
+
+        // The depth is the number of bits of the visit count, so busy positions are replaced last
+        uint8_t depth = 0;
+        for (uint32_t visits = entry.visits; visits != 0; visits >>= 1)
+        {
+            depth++;
+        }
+        entry.depth = depth;
+        config_.table->store(key, entry);
+    }
+
+    /**
+     * Runs playouts on one tree until the budget is used up
+     * @param tree The tree to grow
+     * @param worker The thread's game copy, random generator and counters
+     * @param start Start time of the search
+     */
+    void MctsBot::search(Tree &tree, Worker &worker, chrono::steady_clock::time_point start) const
+    {
+        Game &game = *worker.game;
+        size_t baseJournal = game.journalSize();
+        double reward[GameState::MAX_PLAYERS];
+        while (true)
+        {
+            // Stop at the time budget, then claim one playout of the tree's budget
+            if (config_.maxMillis > 0 &&
+                chrono::steady_clock::now() - start >= chrono::milliseconds(config_.maxMillis))
+            {
+                break;
+            }
+            if (tree.limit > 0 && tree.claimed.fetch_add(1, memory_order_relaxed) >= tree.limit)
+            {
+                break;
+            }
+
+            // Selection - follow UCT until a node still has an untried action to claim
+            uint32_t node = 0;
+            tree.nodes[0].visits.fetch_add(1, memory_order_relaxed);
+            while (true)
+            {
+                Node &n = tree.nodes[node];
+                if (n.nextUntried.load(memory_order_relaxed) < n.untriedCount &&
+                    tree.size.load(memory_order_relaxed) < tree.capacity)
+                {
+                    uint8_t claim = n.nextUntried.fetch_add(1, memory_order_relaxed);
+                    if (claim < n.untriedCount)
+                    {
+                        // Expansion - add one child, then play the rest of the game at random
+                        uint32_t child = expand(tree, worker, node, n.untried[claim]);
+                        if (child != NONE)
+                        {
+                            node = child;
+                            break;
+                        }
+                        // Another thread filled the pool after the check; no node can be added
+                        // any more, so the claim is not needed and the search goes on by selection
+                    }
+                }
+
+                uint32_t child = selectChild(tree, node);
+                if (child == NONE)
+                {
+                    break;
+                }
+                tree.nodes[child].visits.fetch_add(1, memory_order_relaxed);  // Virtual loss
+                game.applyRules(tree.nodes[child].move);
+                node = child;
+            }
+            rollout(worker);
+            score(game, reward);
+
+            // Backpropagation - the visits were counted on the way down, so only the rewards are added;
+            // each node is credited with the reward of the seat that moved into it
+            for (uint32_t n = node; n != 0; n = tree.nodes[n].parent)
+            {
+                Node &c = tree.nodes[n];
+                c.reward.fetch_add(llround(reward[c.mover] * REWARD_SCALE), memory_order_relaxed);
+                if (config_.table)
+                {
+                    updateTable(c.key, reward[c.mover]);
+                }
+            }
+            worker.playouts++;
+
+            // Rewind the game to the root position
+            while (game.journalSize() > baseJournal)
+            {
+                game.undoLast();
+            }
+        }
+    }
+
+    /**
+     * Searches the position and picks an action for the player whose turn it is
+     * @param game The game to search (the threads search copies of it)
+     * @return The action with the most visits (summed over the trees in root mode)
+     * @throws GameException if the current player has no legal action
+     */
+    Action MctsBot::chooseAction(const Game &game)
+    {
+        auto start = chrono::steady_clock::now();
+        vector<size_t> threadPlayouts = move(stats_.threadPlayouts);  // Keep the list's memory
+        threadPlayouts.clear();
+        stats_ = MctsStats();
+        stats_.threadPlayouts = move(threadPlayouts);
+        unsigned int threads = config_.threads;
+        bool rootParallel = config_.parallelism == MctsParallelism::ROOT && threads > 1;
+        size_t treeCount = rootParallel ? threads : 1;
+
+        // Every thread gets its own copy of the game and its own random stream: each
+        // search has a stream of the seed and thread t takes it jumped t times;
+        // a copy left by an earlier search of the same roster only needs the new state
+        Rng stream(config_.seed, searches_);
+        if (workers_.size() < threads)
+        {
+            workers_.resize(threads);
+        }
+        vector<Worker> &workers = workers_;
+        for (unsigned int t = 0; t < threads; ++t)
+        {
+            Worker &worker = workers[t];
+            if (worker.game && worker.game->sameRoster(game))
+            {
+                worker.game->restore(game.snapshot());
+                worker.game->clearJournal();
+            }
+            else
+            {
+                worker.game = copyGame(game);
+            }
+            worker.gen = stream;
+            stream.jump();
+            worker.playouts = 0;
+            worker.rolloutMoves = 0;
+            worker.error = nullptr;
+        }
+        searches_++;
+
+        LegalActions legal;
+        Game &root = *workers[0].game;
+        if (!root.isGameOver())
+        {
+            legal = root.legalActionsRules();
+        }
+        if (legal.empty())
+        {
+            throw GameException("No legal action for the current player");
+        }
+        if (legal.size() == 1)
+        {
+            stats_.nodes = 1;
+            return legal[0];
+        }
+
+        uint64_t probesBefore = 0;
+        uint64_t hitsBefore = 0;
+        if (config_.table)
+        {
+            config_.table->newSearch();
+            probesBefore = config_.table->probes();
+            hitsBefore = config_.table->hits();
+        }
+
+        // Each playout adds at most one node, so a playout budget bounds the tree
+        for (size_t i = 0; i < treeCount; ++i)
+        {
+            size_t limit = config_.maxPlayouts / treeCount + (i < config_.maxPlayouts % treeCount ? 1 : 0);
+            Tree &tree = prepareTree(i, config_.maxPlayouts > 0 ? limit + 1 : max<size_t>(config_.maxNodes, 1));
+            tree.limit = limit;
+            listActions(workers[i], tree.nodes[allocateNode(tree)]);
+        }
+
+        // The calling thread is worker 0
+        auto run = [&](unsigned int t)
+        {
+            try
+            {
+                Tree &tree = *trees_[rootParallel ? t : 0];
+                if (config_.maxPlayouts == 0 || tree.limit > 0)
+                {
+                    search(tree, workers[t], start);
+                }
+            }
+            catch (...)
+            {
+                workers[t].error = current_exception();
+            }
+        };
+        vector<thread> pool;
+        for (unsigned int t = 1; t < threads; ++t)
+        {
+            pool.emplace_back(run, t);
+        }
+        run(0);
+        for (thread &worker : pool)
+        {
+            worker.join();
+        }
+        for (unsigned int t = 0; t < threads; ++t)
+        {
+            if (workers[t].error)
+            {
+                rethrow_exception(workers[t].error);
+            }
+        }
+
+        // Add up the root visits of each action over the trees; the most visited action is the most robust
+        size_t visits[LegalActions::CAPACITY] = {};
+        for (size_t i = 0; i < treeCount; ++i)
+        {
+            const Tree &tree = *trees_[i];
+            for (uint32_t child = tree.nodes[0].firstChild.load(); child != NONE; child = tree.nodes[child].nextSibling)
+            {
+                const Node &c = tree.nodes[child];
+                for (size_t a = 0; a < legal.size(); ++a)
+                {
+                    if (legal[a] == c.move)
+                    {
+                        visits[a] += c.visits.load();
+                    }
+                }
+            }
+            stats_.nodes += tree.size.load();
+        }
+        size_t best = 0;
+        for (size_t a = 1; a < legal.size(); ++a)
+        {
+            if (visits[a] > visits[best])
+            {
+                best = a;
+            }
+        }
+
+        for (const Worker &worker : workers)
+        {
+            stats_.playouts += worker.playouts;
+            stats_.rolloutMoves += worker.rolloutMoves;
+            stats_.threadPlayouts.push_back(worker.playouts);
+        }
+        if (config_.table)
+        {
+            stats_.tableProbes = config_.table->probes() - probesBefore;
+            stats_.tableHits = config_.table->hits() - hitsBefore;
+        }
+        stats_.elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        return legal[best];
+    }
+}
@@ -0,0 +1,284 @@
+//orel8155@gmail.com
+/**
+ * @file MctsBot.hpp
+ * @brief Monte Carlo Tree Search player for the Coup game
+ *
+ * The bot searches the actions of the player whose turn it is with UCT
+ * selection and uniformly random rollouts. Every search thread plays on its
+ * own copy of the game with Game::applyRules (the rule-table dispatch under
+ * the game's rule values, which plays exactly like Game::apply) and rewinds
+ * with Game::undoLast, so the caller's game is never modified.
+ *
+ * With more than one thread the search is parallelized in one of two ways:
+ * - Root parallelization: each thread grows an independent tree and the
+ *   visit counts of the root actions are added up at the end.
+ * - Tree parallelization: all threads grow one shared tree. Node statistics
+ *   are atomics, new children are published with compare-and-swap, and each
+ *   thread adds a virtual loss (a visit without reward) to the nodes on its
+ *   path so that other threads are steered to different branches.
+ *
+ * With a transposition table, every node also adds its playouts to a table
+ * entry keyed by the position hash, and selection uses that entry's mean
+ * when it has seen more playouts than the node itself. Positions reached by
+ * different move orders, or in other trees, then share their statistics.
+ */
+#pragma once  // Ensures this header file is included only once during compilation
+
+#include "Game.hpp"      // Core game logic
+#include "Action.hpp"    // Action and LegalActions
+#include "TranspositionTable.hpp" // Statistics shared between transposed positions
+#include <atomic>        // Lock-free node statistics
+#include <chrono>        // Time budget
+#include <cstdint>       // For fixed-width integers
+#include <exception>     // For exception_ptr
+#include <memory>        // For unique_ptr
+#include "Rng.hpp"       // Random number generation
+#include <vector>        // For vector container
+using namespace std;     // Using standard namespace
+
+namespace coup
+{
+    /**
+     * How several search threads share the work
+     */
+    enum class MctsParallelism
+    {
+        ROOT,   // Independent trees, merged at the end
+        TREE    // One shared tree with virtual loss
+    };
+
+    /**
+     * Settings of the MCTS bot
+     * The search stops at whichever budget is reached first (0 = no limit of that kind)
+     */
+    struct MctsConfig
+    {
+        size_t maxPlayouts = 1000;   // Playouts per move over all threads (0 = limited by time only)
+        int maxMillis = 0;           // Milliseconds per move (0 = limited by playouts only)
+        double exploration = 1.41;   // UCT exploration constant
+        int maxRolloutDepth = 200;   // Random moves per rollout before the position is scored
+        uint64_t seed = 0;           // Seed of the bot's random number generators
+        unsigned int threads = 1;    // Search threads (each one plays on its own copy of the game)
+        MctsParallelism parallelism = MctsParallelism::TREE; // How the threads share the work
+        size_t maxNodes = 1 << 18;   // Node limit of a tree when the search is limited by time only (at least 1)
+        TranspositionTable *table = nullptr; // Shared position statistics (not owned, may be null)
+    };
+
+    /**
+     * Statistics of the last search
+     */
+    struct MctsStats
+    {
+        size_t playouts = 0;            // Completed playouts over all threads
+        size_t nodes = 0;               // Tree nodes created over all trees
+        size_t rolloutMoves = 0;        // Actions played in rollouts
+        double elapsedMs = 0;           // Search time in milliseconds
+        vector<size_t> threadPlayouts;  // Completed playouts of each thread
+        uint64_t tableProbes = 0;       // Transposition table lookups (including other searches sharing the table)
+        uint64_t tableHits = 0;         // Transposition table lookups that found their position
+
+        /**
+         * Gets the transposition table hit rate of the search
+         * @return Hits per lookup (0 without a table)
+         */
+        double tableHitRate() const { return tableProbes == 0 ? 0 : static_cast<double>(tableHits) / tableProbes; }
+
+        /**
+         * Gets the search speed
+         * @return Playouts per second (0 if no time was measured)
+         */
+        double playoutsPerSecond() const { return elapsedMs > 0 ? playouts * 1000.0 / elapsedMs : 0; }
+
+        /**
+         * Gets the search speed of an average thread
+         * Staying close to playoutsPerSecond() of one thread means the search scales linearly
+         * @return Playouts per second per thread
+         */
+        double playoutsPerSecondPerThread() const
+        {
+            return threadPlayouts.empty() ? 0 : playoutsPerSecond() / threadPlayouts.size();
+        }
+    };
+
+    /**
+     * MctsBot class - chooses actions with Monte Carlo Tree Search
+     * Works for any role; every player is assumed to try to win for themselves
+     */
+    class MctsBot
+    {
+    public:
+        /**
+         * Constructor for the MCTS bot
+         * If neither budget is set, the default playout budget is used
+         * @param config Search budget and parameters
+         */
+        explicit MctsBot(const MctsConfig &config = MctsConfig());
+
+        /**
+         * Destructor - frees the search trees
+         */
+        ~MctsBot();
+
+        /**
+         * Searches the position and picks an action for the player whose turn it is
+         * @param game The game to search (the threads search copies of it)
+         * @return The action with the most visits (summed over the trees in root mode)
+         * @throws GameException if the current player has no legal action
+         */
+        Action chooseAction(const Game &game);
+
+        /**
+         * Gets the statistics of the last search
+         * @return The statistics
+         */
+        const MctsStats &lastStats() const { return stats_; }
+
+        /**
+         * Gets the bot's settings
+         * @return The settings
+         */
+        const MctsConfig &config() const { return config_; }
+
+        /**
+         * Restarts the bot's random streams from a new seed
+         * The bot then searches like a new bot built with that seed, but keeps
+         * its trees and game copies, so a pooled bot can play game after game
+         * @param seed The new seed
+         */
+        void reseed(uint64_t seed)
+        {
+            config_.seed = seed;
+            searches_ = 0;
+        }
+
+    private:
+        /**
+         * One position in a search tree
+         * The action list is written once before the node is published to
+         * other threads; only the atomic fields change afterwards.
+         */
+        struct Node
+        {
+            Action move;                                 // Action that led to this node
+            uint8_t mover = NO_SEAT;                     // Seat that played the move
+            uint8_t untriedCount = 0;                    // Number of actions in the untried list
+            atomic<uint8_t> nextUntried{0};              // Next untried action to claim
+            uint32_t parent = 0;                         // Parent node index
+            atomic<uint32_t> firstChild{NONE};           // First published child node index
+            uint32_t nextSibling = NONE;                 // Next child of the parent
+            atomic<uint32_t> visits{0};                  // Playouts through this node, including virtual losses
+            atomic<int64_t> reward{0};                   // Total reward of the mover in units of REWARD_SCALE
+            uint64_t key = 0;                            // Transposition table key (position hash and mover)
+            Action untried[LegalActions::CAPACITY];      // Actions not expanded yet, in random order
+        };
+
+        /**
+         * Fixed-size node pool of one tree (index 0 is the root)
+         */
+        struct Tree
+        {
+            unique_ptr<Node[]> nodes;    // The node pool
+            size_t capacity = 0;         // Number of nodes in the pool
+            atomic<uint32_t> size{0};    // Number of nodes handed out
+            size_t limit = 0;            // Playout budget of the tree (0 = limited by time only)
+            atomic<size_t> claimed{0};   // Playouts started on the tree's budget
+        };
+
+        /**
+         * State of one search thread
+         */
+        struct Worker
+        {
+            unique_ptr<Game> game;       // The thread's copy of the searched game
+            Rng gen;                     // The thread's random number generator
+            size_t playouts = 0;         // Playouts completed by the thread
+            size_t rolloutMoves = 0;     // Rollout actions played by the thread
+            exception_ptr error;         // Exception that stopped the thread's search, if any
+        };
+
+        /**
+         * Node index meaning "no node"
+         */
+        static constexpr uint32_t NONE = 0xFFFFFFFF;
+
+        /**
+         * Fixed-point scale of node rewards (rewards are fractions with a denominator of at most 6)
+         */
+        static constexpr double REWARD_SCALE = 1 << 20;
+
+        MctsConfig config_;               // Search budget and parameters
+        MctsStats stats_;                 // Statistics of the last search
+        unsigned int searches_;           // Number of searches so far (each search takes its own stream of the seed)
+        vector<unique_ptr<Tree>> trees_;  // Search trees, kept between searches to reuse their memory
+        vector<Worker> workers_;          // Search threads' state, kept between searches to reuse their game copies
+
+        /**
+         * Makes sure a tree exists and can hold a number of nodes, then empties it
+         * @param index The tree index
+         * @param capacity The number of nodes needed
+         * @return The empty tree
+         */
+        Tree &prepareTree(size_t index, size_t capacity);
+
+        /**
+         * Takes a free node from a tree's pool and clears it
+         * @param tree The tree
+         * @return The node index, or NONE if the pool is full
+         */
+        static uint32_t allocateNode(Tree &tree);
+
+        /**
+         * Lists the untried actions of a node from the current position, in random order
+         * @param worker The thread, with its game in the node's position
+         * @param node The node
+         */
+        static void listActions(Worker &worker, Node &node);
+
+        /**
+         * Picks the published child with the highest UCT value
+         * @param tree The tree
+         * @param node The node index
+         * @return The chosen child index, or NONE if no child is published yet
+         */
+        uint32_t selectChild(const Tree &tree, uint32_t node) const;
+
+        /**
+         * Plays a claimed untried action of a node and publishes its child
+         * @param tree The tree
+         * @param worker The thread, with its game in the node's position
+         * @param node The node index
+         * @param action The claimed action
+         * @return The new child index, or NONE (with the game unchanged) if the pool is full
+         */
+        uint32_t expand(Tree &tree, Worker &worker, uint32_t node, Action action) const;
+
+        /**
+         * Adds one playout's reward to a node's transposition table entry
+         * @param key The node's table key
+         * @param reward The reward of the node's mover
+         */
+        void updateTable(uint64_t key, double reward) const;
+
+        /**
+         * Runs playouts on one tree until the budget is used up
+         * @param tree The tree to grow
+         * @param worker The thread's game copy, random generator and counters
+         * @param start Start time of the search
+         */
+        void search(Tree &tree, Worker &worker, chrono::steady_clock::time_point start) const;
+
+        /**
+         * Plays random actions until the game ends or the depth limit
+         * @param worker The thread, with its game in the leaf's position
+         */
+        void rollout(Worker &worker) const;
+
+        /**
+         * Scores the current position for every seat
+         * The winner gets 1; an unfinished game is shared among the remaining players
+         * @param game The game at the end of a rollout
+         * @param reward Reward of each seat
+         */
+        void score(const Game &game, double reward[GameState::MAX_PLAYERS]) const;
+    };
+}
@@ -0,0 +1,156 @@
+//orel8155@gmail.com
+/**
+ * @file PackedState.hpp
+ * @brief Canonical 32-byte encoding of a position, for storing large numbers of them
+ *
+ * A PackedState holds a GameState plus the role of every seat in four 64-bit
+ * words. Each seat has its own 32-bit lane (two lanes per word for words
+ * 0-2) and word 3 holds the bank and the game-wide seats:
+ *
+ *   seat lane: coins 0-15 | role 16-18 | active 19 | blocked economic 20 |
+ *              blocked arrest 21 | last action 22-24 | last target 25-27
+ *   word 3:    bank 0-31 | player count 32-34 | current seat 35-37 |
+ *              previous seat 38-40 | arrested seat 41-43 |
+ *              arrested player seat 44-46 | last couped seat 47-49 | flags 50-51
+ *
+ * Seats and actions take three bits, with NO_SEAT and NO_ACTION stored as 7.
+ * Lanes of empty seats and unused bits are always 0, so equal positions have
+ * equal bytes and a PackedState can be hashed or compared with memcmp.
+ * Packing and unpacking are branch-free shifts over a fixed number of seats.
+ */
+#pragma once  // Ensures this header file is included only once during compilation
+
+#include "GameState.hpp"  // The state being packed
+#include "Player.hpp"     // For Role
+#include <array>          // For the words and the roles
+#include <cstdint>        // For fixed-width integers
+#include <type_traits>    // For is_trivially_copyable
+
+namespace coup
+{
+    /**
+     * Largest coin count a packed seat can hold
+     */
+    constexpr int32_t PACKED_MAX_COINS = 0xFFFF;
+
+    /**
+     * @struct PackedState
+     * @brief A position (state and roles) packed into 32 bytes
+     */
+    struct PackedState
+    {
+        array<uint64_t, 4> words{};  // Seat lanes in words 0-2, game-wide fields in word 3
+
+        bool operator==(const PackedState &other) const { return words == other.words; }
+        bool operator!=(const PackedState &other) const { return words != other.words; }
+    };
+    static_assert(sizeof(PackedState) == 32, "A packed state must take exactly 32 bytes");
+    static_assert(is_trivially_copyable<PackedState>::value, "A packed state must be copyable with memcpy");
+
+    /**
+     * Gets the 3-bit code of a seat or action value (NO_SEAT and NO_ACTION become 7)
+     * @param value A seat, an ActionType code, NO_SEAT or NO_ACTION
+     * @return The code
+     */
+    constexpr uint64_t packedCode(uint8_t value)
+    {
+        return value & 7u;
+    }
+
+    /**
+     * Gets the seat or action value of a 3-bit code
+     * @param code The code
+     * @return The value (7 becomes NO_SEAT, which equals NO_ACTION)
+     */
+    constexpr uint8_t unpackedCode(uint64_t code)
+    {
+        return static_cast<uint8_t>(code == 7 ? NO_SEAT : code);
+    }
+
+    /**
+     * Checks if a state can be packed without losing information
+     * @param state The state
+     * @return True if every coin count is in [0, PACKED_MAX_COINS] and every seat field is valid
+     */
+    inline bool canPack(const GameState &state)
+    {
+        auto seatOk = [&state](uint8_t seat) { return seat == NO_SEAT || seat < state.playerCount; };
+        bool ok = state.playerCount <= GameState::MAX_PLAYERS && state.currentSeat < GameState::MAX_PLAYERS &&
+                  state.previousSeat < GameState::MAX_PLAYERS && seatOk(state.arrestedSeat) &&
+                  seatOk(state.arrestedPlayerSeat) && seatOk(state.lastCoupedSeat) && state.flags < 4;
+        for (size_t seat = 0; ok && seat < state.playerCount; ++seat)
+        {
+            const PlayerState &player = state.players[seat];
+            ok = player.coins >= 0 && player.coins <= PACKED_MAX_COINS && player.flags < 8 &&
+                 (player.lastAction == NO_ACTION || player.lastAction < ACTION_TYPE_COUNT) && seatOk(player.lastTarget);
+        }
+        return ok;
+    }
+
+    /**
+     * Packs a state and the roles of its seats
+     * The result is only meaningful if canPack(state) is true
+     * @param state The state
+     * @param roles The role of each seat (entries past state.playerCount are ignored)
+     * @param packed Receives the encoding
+     */
+    inline void packState(const GameState &state, const array<Role, GameState::MAX_PLAYERS> &roles, PackedState &packed)
+    {
+        uint64_t lanes[GameState::MAX_PLAYERS];
+        for (size_t seat = 0; seat < GameState::MAX_PLAYERS; ++seat)
+        {
+            const PlayerState &player = state.players[seat];
+            uint64_t lane = static_cast<uint64_t>(player.coins & 0xFFFF) |
+                            (static_cast<uint64_t>(roles[seat]) << 16) |
+                            (static_cast<uint64_t>(player.flags & 7u) << 19) |
+                            (packedCode(player.lastAction) << 22) |
+                            (packedCode(player.lastTarget) << 25);
+            lanes[seat] = seat < state.playerCount ? lane : 0;  // Empty seats stay 0
+        }
+        packed.words[0] = lanes[0] | (lanes[1] << 32);
+        packed.words[1] = lanes[2] | (lanes[3] << 32);
+        packed.words[2] = lanes[4] | (lanes[5] << 32);
+        packed.words[3] = static_cast<uint64_t>(static_cast<uint32_t>(state.bank)) |
+                          (static_cast<uint64_t>(state.playerCount) << 32) |
+                          (packedCode(state.currentSeat) << 35) |
+                          (packedCode(state.previousSeat) << 38) |
+                          (packedCode(state.arrestedSeat) << 41) |
+                          (packedCode(state.arrestedPlayerSeat) << 44) |
+                          (packedCode(state.lastCoupedSeat) << 47) |
+                          (static_cast<uint64_t>(state.flags & 3u) << 50);
+    }
+
+    /**
+     * Unpacks a state and the roles of its seats
+     * Empty seats come back as zeroed PlayerState entries and Role::GENERAL,
+     * as in a snapshot, so a packed snapshot unpacks to identical bytes
+     * @param packed The encoding
+     * @param state Receives the state
+     * @param roles Receives the role of each seat
+     */
+    inline void unpackState(const PackedState &packed, GameState &state, array<Role, GameState::MAX_PLAYERS> &roles)
+    {
+        state = GameState{};
+        uint64_t word = packed.words[3];
+        state.bank = static_cast<int32_t>(static_cast<uint32_t>(word));
+        state.playerCount = static_cast<uint8_t>((word >> 32) & 7u);
+        state.currentSeat = unpackedCode((word >> 35) & 7u);
+        state.previousSeat = unpackedCode((word >> 38) & 7u);
+        state.arrestedSeat = unpackedCode((word >> 41) & 7u);
+        state.arrestedPlayerSeat = unpackedCode((word >> 44) & 7u);
+        state.lastCoupedSeat = unpackedCode((word >> 47) & 7u);
+        state.flags = static_cast<uint8_t>((word >> 50) & 3u);
+
+        for (size_t seat = 0; seat < GameState::MAX_PLAYERS; ++seat)
+        {
+            uint64_t lane = (packed.words[seat / 2] >> (32 * (seat % 2))) & 0xFFFFFFFFu;
+            bool used = seat < state.playerCount;
+            PlayerState &player = state.players[seat];
+            player.coins = static_cast<int32_t>(lane & 0xFFFF);
+            player.flags = static_cast<uint8_t>((lane >> 19) & 7u);
+            player.lastAction = used ? unpackedCode((lane >> 22) & 7u) : 0;
+            player.lastTarget = used ? unpackedCode((lane >> 25) & 7u) : 0;
+            roles[seat] = static_cast<Role>((lane >> 16) & 7u);
+        }
+    }
+}
@@ -20,9 +20,69 @@ namespace coup
      * @param role The role of the player (General, Governor, etc.)
      */
     Player::Player(Game &game, const string &name, Role role)
-        : game_(game), name_(name), coins_(0), active_(true), blocked_from_economic_(false),
-          blocked_from_arresting_(false), last_action_(""), last_target_(""), role_(role)
+        : game_(game), name_(name), table_(&game.table_), seat_(static_cast<uint8_t>(game.players_.size())),
+          hash_(&game.hash_)
     {
+        if (seat_ >= DefaultRules::MAX_PLAYERS)
+        {
+            throw GameException("Maximum number of players (" + to_string(DefaultRules::MAX_PLAYERS) + ") reached");
+        }
+
+        // Claim the next seat of the game's table (Game::createPlayer makes it active);
+        // the new generation makes handles to an earlier player of the seat stale
+        table_->generation[seat_]++;
+        table_->coins[seat_] = 0;
+        table_->roles[seat_] = role;
+        table_->lastAction[seat_] = NO_ACTION;
+        table_->lastTarget[seat_] = NO_SEAT;
+        setSeatBit(table_->blockedEconomic, false);
+        setSeatBit(table_->blockedArrest, false);
+    }
+
+    /**
+     * Gets the name of the target of the player's last action
+     * The target is stored as a seat; the name is looked up only for display
+     * @return The target's name, or an empty view if the action had no target
+     */
+    string_view Player::get_last_target() const
+    {
+        uint8_t target = lastTargetSeat();
+        return target == NO_SEAT ? string_view() : game_.playerName(target);
+    }
+
+    /**
+     * Sets whether the player is active in the game
+     * The game's active seats are updated together with the flag, so it
+     * never has to scan the players to find out who is left
+     * @param active True for active, false for inactive
+     */
+    void Player::setActive(bool active)
+    {
+        if (active == isActive())
+        {
+            return;
+        }
+        rehash(ZobristField::ACTIVE, !active, active);
+        game_.updateActiveSeat(seat_, active);
+    }
+
+    /**
+     * Checks if the player must perform a coup (holds at least mustCoupCoins coins)
+     * @return True if player must coup, false otherwise
+     */
+    bool Player::mustPerformCoup() const
+    {
+        return coins() >= game_.rules().mustCoupCoins;
+    }
+
+    /**
+     * Checks if arresting a player moves a coin from them to the arrester
+     * @param target The arrested player
+     * @return The target role's arrestTakesCoin in the game's rules
+     */
+    bool Player::arrestTakesCoin(const Player &target) const
+    {
+        return game_.rules().role(target.role()).arrestTakesCoin;
     }
 
     /**
@@ -31,228 +91,518 @@ namespace coup
      */
     void Player::checkTurn() const
     {
-        // Verify it's this player's turn based on role
-        if (game_.turn() != role_)
+        throwIfFailed(validateTurn());
+    }
+
+    /**
+     * Checks if it's the player's turn and if they're active
+     * @return ActionStatus::OK, NOT_YOUR_TURN or PLAYER_INACTIVE
+     */
+    ActionStatus Player::validateTurn() const
+    {
+        // Verify it's this player's turn by seat (roles may repeat)
+        if (game_.currentSeat() != seat_)
         {
-            throw InvalidTurn("It is not your turn");
+            return ActionStatus::NOT_YOUR_TURN;
         }
 
         // Verify the player is still active in the game
-        if (!active_)
+        if (!isActive())
         {
-            throw InvalidOperation("You are not active");
+            return ActionStatus::PLAYER_INACTIVE;
         }
+        return ActionStatus::OK;
     }
 
     /**
-     * Gather action - collect one coin from the treasury
-     * Basic economic action available to all roles
+     * Checks the rules of gather (also used by the basic tax action)
+     * @return ActionStatus::OK or the rule that forbids the action
      */
-    void Player::gather()
+    ActionStatus Player::validateGather() const
     {
-        // Players with 10 or more coins must coup instead of gathering
-        if (coins_ >= 10)
+        // Players at the forced-coup threshold must coup instead of gathering
+        if (coins() >= game_.rules().mustCoupCoins)
         {
-            throw InvalidOperation("Must perform coup when you have 10 or more coins");
+            return ActionStatus::MUST_COUP;
         }
-        
-        checkTurn(); // Verify it's this player's turn
-        
+
+        // Verify it's this player's turn
+        ActionStatus turn = validateTurn();
+        if (turn != ActionStatus::OK)
+        {
+            return turn;
+        }
+
         // Check if player is under economic sanctions
-        if (blocked_from_economic_)
+        if (blocked_from_economic())
         {
-            throw InvalidOperation("You are blocked from economic actions");
+            return ActionStatus::BLOCKED_ECONOMIC;
         }
+        return ActionStatus::OK;
+    }
 
-        addCoins(1); // Add one coin to player's balance
-        last_action_ = "gather"; // Record the action taken
-        last_target_ = ""; // No target for gather action
+    /**
+     * Checks the rules of tax
+     * For most roles these are the rules of gather. A role with taxChecksBlockFirst
+     * (the Governor) may tax outside its turn but is still stopped by a sanction,
+     * which is reported first, and by the coup rule
+     * @return ActionStatus::OK or the rule that forbids the action
+     */
+    ActionStatus Player::validateTax() const
+    {
+        if (!game_.rules().role(role()).taxChecksBlockFirst)
+        {
+            return validateGather();
+        }
 
-        // Clear previous action from game state
+        // Check if the player is currently blocked from performing economic actions
+        if (blocked_from_economic())
+        {
+            return ActionStatus::BLOCKED_ECONOMIC;
+        }
+        // Players with mustCoupCoins or more must coup instead
+        if (coins() >= game_.rules().mustCoupCoins)
+        {
+            return ActionStatus::MUST_COUP;
+        }
+        return ActionStatus::OK;
+    }
 
-        game_.advanceTurn(); // Move to the next player's turn
+    /**
+     * Checks the rules of bribe
+     * @return ActionStatus::OK or the rule that forbids the action
+     */
+    ActionStatus Player::validateBribe() const
+    {
+        // Players at the forced-coup threshold must coup instead of bribing
+        if (coins() >= game_.rules().mustCoupCoins)
+        {
+            return ActionStatus::MUST_COUP;
+        }
+
+        // Check if player has enough coins for bribe
+        if (coins() < game_.rules().bribeCost)
+        {
+            return ActionStatus::NOT_ENOUGH_COINS_TO_BRIBE;
+        }
+        return ActionStatus::OK;
     }
 
     /**
-     * Tax action - collect two coins from the treasury
-     * Basic economic action available to all roles
+     * Checks the rules of arrest
+     * @param target The player to arrest
+     * @return ActionStatus::OK or the rule that forbids the action
      */
-    void Player::tax()
+    ActionStatus Player::validateArrest(const Player &target) const
     {
-        // Players with 10 or more coins must coup instead of taxing
-        if (coins_ >= 10)
+        // Check if player is blocked from arresting
+        if (blocked_from_arresting())
         {
-            throw InvalidOperation("Must perform coup when you have 10 or more coins");
+            return ActionStatus::BLOCKED_ARREST;
         }
-        
-        checkTurn(); // Verify it's this player's turn
-        
-        // Check if player is under economic sanctions
-        if (blocked_from_economic_)
+
+        // Check if the target is already arrested
+        if (game_.arrestedSeat() == target.seat_)
         {
-            throw InvalidOperation("You are blocked from economic actions");
+            return ActionStatus::ALREADY_ARRESTED;
         }
 
-        game_.removeCoinsFromBank(2); // Remove 2 coins from the game bank
-        addCoins(2); // Add two coins to player's balance
-        last_action_ = "tax"; // Record the action taken
-        last_target_ = ""; // No target for tax action
+        // Players at the forced-coup threshold must coup instead of arresting
+        if (coins() >= game_.rules().mustCoupCoins)
+        {
+            return ActionStatus::MUST_COUP;
+        }
 
-        // Record the action in the player's action map
+        // The target must be able to pay the coin the arrest takes
+        if (arrestTakesCoin(target) && target.coins() < 1)
+        {
+            return ActionStatus::TARGET_CANNOT_PAY;
+        }
+        return ActionStatus::OK;
+    }
 
-        game_.advanceTurn(); // Move to the next player's turn
+    /**
+     * Checks the rules of sanction
+     * @param target The player to sanction
+     * @return ActionStatus::OK or the rule that forbids the action
+     */
+    ActionStatus Player::validateSanction(const Player &target) const
+    {
+        // Players at the forced-coup threshold must coup instead of sanctioning
+        if (coins() >= game_.rules().mustCoupCoins)
+        {
+            return ActionStatus::MUST_COUP;
+        }
+
+        // The sanction costs its base price plus any penalty the target's role imposes
+        if (coins() < game_.rules().sanctionCost + target.sanctionPenalty())
+        {
+            return ActionStatus::NOT_ENOUGH_COINS;
+        }
+        return ActionStatus::OK;
     }
 
     /**
-     * Bribe action - pay coins to gain advantage
-     * Costs 4 coins and removes economic sanctions
+     * Checks the rules of invest
+     * @return ActionStatus::OK or the rule that forbids the action
      */
-    void Player::bribe()
+    ActionStatus Player::validateInvest() const
     {
-        // Players with 10 or more coins must coup instead of bribing
-        if (coins_ >= 10)
+        // Only roles whose rules include the invest action (the Baron) can invest
+        if (!game_.rules().role(role()).canInvest)
         {
-            throw InvalidOperation("Must perform coup when you have 10 or more coins");
+            return ActionStatus::NOT_SUPPORTED;
         }
-        
-        // Check if player has enough coins for bribe
-        if (coins_ < 4)
+        if (coins() < game_.rules().investCost)
         {
-            throw InvalidOperation("You do not have enough coins to bribe");
+            return ActionStatus::NOT_ENOUGH_COINS;
         }
-        
-        removeCoins(4); // Pay 4 coins for the bribe
-        last_action_ = "bribe"; // Record the action taken
-        last_target_ = ""; // No target for bribe action
+        return ActionStatus::OK;
+    }
 
-        // If the player is under economic sanctions, remove them
-        if (game_.getPlayerByName(name_)->blocked_from_economic())
+    /**
+     * Checks the rules of coup
+     * @param target The player to eliminate
+     * @return ActionStatus::OK or the rule that forbids the action
+     */
+    ActionStatus Player::validateCoup(const Player &target) const
+    {
+        // Verify player can pay for the coup
+        if (coins() < game_.rules().coupCost)
+        {
+            return ActionStatus::NOT_ENOUGH_COINS;
+        }
+
+        // Verify the target is active before removing
+        if (!target.isActive())
+        {
+            return ActionStatus::TARGET_INACTIVE;
+        }
+
+        // Prevent self-coup
+        if (this == &target)
         {
-            game_.getPlayerByName(name_)->setBlockedFromEconomic(false);
+            return ActionStatus::SELF_TARGET;
         }
+        return ActionStatus::OK;
+    }
+
+    /**
+     * Gather action - collect one coin from the treasury
+     * Basic economic action available to all roles
+     */
+    void Player::gather()
+    {
+        throwIfFailed(tryGather());
+    }
+
+    /**
+     * Tax action - collect taxes from the treasury (role-specific amount)
+     */
+    void Player::tax()
+    {
+        throwIfFailed(tryTax());
+    }
+
+    /**
+     * Bribe action - pay coins to gain advantage
+     */
+    void Player::bribe()
+    {
+        throwIfFailed(tryBribe());
     }
 
     /**
      * Arrest action - arrests another player
-     * Effects vary based on the arrested player's role
-     * 
      * @param target Pointer to the player being arrested
      */
     void Player::arrest(shared_ptr<Player> &target)
     {
-        // Check if player is blocked from arresting
-        if (blocked_from_arresting_)
+        throwIfFailed(tryArrest(target));
+    }
+
+    /**
+     * Sanction action - imposes economic sanctions on another player
+     * @param target Reference to the player being sanctioned
+     */
+    void Player::sanction(Player &target)
+    {
+        throwIfFailed(trySanction(target));
+    }
+
+    /**
+     * Coup action - eliminates another player from the game
+     * @param target Pointer to the player being eliminated
+     */
+    void Player::coup(shared_ptr<Player> &target)
+    {
+        throwIfFailed(tryCoup(target));
+    }
+
+    /**
+     * Gather action - collect one coin from the treasury
+     * Basic economic action available to all roles
+     * @return ActionStatus::OK or the rule that forbids the action
+     */
+    ActionStatus Player::tryGather()
+    {
+        ActionStatus status = validateGather();
+        if (status != ActionStatus::OK)
         {
-            throw InvalidOperation("You are blocked from arrest actions");
+            return status;
         }
 
-        // Check if the target is already arrested
-        if (game_.getArrestedPlayerName() == target->name())
+        addCoins(1); // Add one coin to player's balance
+        recordAction(ActionType::GATHER); // Record the action taken (no target)
+
+        game_.advanceTurn(); // Move to the next player's turn
+        return ActionStatus::OK;
+    }
+
+    /**
+     * Tax action - collect two coins from the treasury
+     * Basic economic action available to all roles
+     * @return ActionStatus::OK or the rule that forbids the action
+     */
+    ActionStatus Player::tryTax()
+    {
+        ActionStatus status = validateTax();
+        if (status != ActionStatus::OK)
         {
-            throw InvalidOperation("You cannot arrest the same player twice in a row");
+            return status;
         }
 
-        // Players with 10 or more coins must coup instead of arresting
-        if (coins_ >= 10)
+        const RoleRules &rules = game_.rules().role(role());
+        game_.removeCoinsFromBank(rules.taxBankCost); // Take the role's taxBankCost from the game bank
+        addCoins(rules.taxGain); // Add the role's taxGain to the player's balance
+        recordAction(ActionType::TAX); // Record the action taken (no target)
+
+        game_.advanceTurn(); // Move to the next player's turn
+        return ActionStatus::OK;
+    }
+
+    /**
+     * Bribe action - pay coins to gain advantage
+     * Costs the rules' bribeCost (4 coins in the standard rules) and removes economic sanctions
+     * @return ActionStatus::OK or the rule that forbids the action
+     */
+    ActionStatus Player::tryBribe()
+    {
+        ActionStatus status = validateBribe();
+        if (status != ActionStatus::OK)
         {
-            throw InvalidOperation("Must perform coup when you have 10 or more coins");
+            return status;
         }
 
-        // Record the action and target
-        last_action_ = "arrest";
-        last_target_ = target->name();
-        game_.setArrestedPlayerName(target->name());
+        removeCoins(game_.rules().bribeCost); // Pay for the bribe
+        recordAction(ActionType::BRIBE); // Record the action taken (no target)
 
-        // Allow the target to react to being arrested
-        target->react_to_arrest();
+        // If the player is under economic sanctions, remove them
+        setBlockedFromEconomic(false);
+        return ActionStatus::OK;
+    }
 
-        // Generals and Merchants have special immunity to monetary effects
-        if (target->role() != Role::GENERAL && target->role() != Role::MERCHANT)
+    /**
+     * Arrest action - arrests another player
+     * Effects vary based on the arrested player's role
+     * 
+     * @param target The player being arrested
+     * @return ActionStatus::OK or the rule that forbids the action
+     */
+    ActionStatus Player::tryArrest(Player &target)
+    {
+        ActionStatus status = validateArrest(target);
+        if (status != ActionStatus::OK)
         {
-            target->removeCoins(1); // Take 1 coin from target
+            return status;
+        }
+
+        // Record the action and target
+        recordAction(ActionType::ARREST, &target);
+        game_.setArrestedSeat(target.seat_);
+
+        // Roles without arrestTakesCoin (Generals and Merchants) are immune to the coin transfer
+        if (arrestTakesCoin(target))
+        {
+            target.removeCoins(1); // Take 1 coin from target
             addCoins(1); // Add 1 coin to arresting player
         }
 
+        // Allow the target to react to being arrested; after the transfer, so a
+        // fee is only paid from the coins the target has left
+        target.react_to_arrest();
+
         game_.advanceTurn(); // Move to the next player's turn
+        return ActionStatus::OK;
+    }
+
+    /**
+     * Arrest action through a handle
+     * @param target Handle of the player being arrested
+     * @return ActionStatus::OK, INVALID_TARGET if the handle is stale, or the rule that forbids the action
+     */
+    ActionStatus Player::tryArrest(PlayerHandle target)
+    {
+        Player *player = game_.resolve(target);
+        return player ? tryArrest(*player) : ActionStatus::INVALID_TARGET;
     }
 
     /**
      * Sanction action - imposes economic sanctions on another player
-     * Costs 3 coins and blocks target from economic actions
+     * Costs the rules' sanctionCost (3 coins in the standard rules) and blocks target from economic actions
      * 
      * @param target Reference to the player being sanctioned
+     * @return ActionStatus::OK or the rule that forbids the action
      */
-    void Player::sanction(Player &target)
+    ActionStatus Player::trySanction(Player &target)
     {
-        // Players with 10 or more coins must coup instead of sanctioning
-        if (coins_ >= 10)
+        ActionStatus status = validateSanction(target);
+        if (status != ActionStatus::OK)
         {
-            throw InvalidOperation("You must perform a coup when you have 10 or more coins");
+            return status;
         }
-        
-        checkCoins(3); // Verify player has at least 3 coins
-        
+
         // Pay for the sanction
-        removeCoins(3);
-        game_.addCoinsToBank(3); // Return coins to the game bank
+        removeCoins(game_.rules().sanctionCost);
+        game_.addCoinsToBank(game_.rules().sanctionCost); // Return coins to the game bank
         
         // Record the action and target
-        last_action_ = "sanction";
-        last_target_ = target.name();
+        recordAction(ActionType::SANCTION, &target);
 
         // Apply economic sanctions to the target
         target.setBlockedFromEconomic(true);
 
         // Allow the target to react to sanctions
-        try 
-        {
-            target.react_to_sanction();
-        }
-        catch (const InvalidOperation &e)
+        target.react_to_sanction();
+
+        // Some roles make the sanctioning player pay an additional penalty
+        int penalty = target.sanctionPenalty();
+        if (penalty > 0)
         {
-            // Additional penalty if reaction fails
-            removeCoins(1);
-            game_.addCoinsToBank(1); // Return coin to the game bank
+            removeCoins(penalty);
+            game_.addCoinsToBank(penalty); // Return the penalty to the game bank
         }
 
         game_.advanceTurn(); // Move to the next player's turn
+        return ActionStatus::OK;
+    }
+
+    /**
+     * Sanction action through a handle
+     * @param target Handle of the player being sanctioned
+     * @return ActionStatus::OK, INVALID_TARGET if the handle is stale, or the rule that forbids the action
+     */
+    ActionStatus Player::trySanction(PlayerHandle target)
+    {
+        Player *player = game_.resolve(target);
+        return player ? trySanction(*player) : ActionStatus::INVALID_TARGET;
     }
 
     /**
      * Coup action - eliminates another player from the game
-     * Costs 7 coins and removes the target from active play
+     * Costs the rules' coupCost (7 coins in the standard rules) and removes the target from active play
      * 
-     * @param target Pointer to the player being eliminated
+     * @param target The player being eliminated
+     * @return ActionStatus::OK or the rule that forbids the action
      */
-    void Player::coup(shared_ptr<Player> &target)
+    ActionStatus Player::tryCoup(Player &target)
     {
-        checkCoins(7); // Verify player has at least 7 coins
-
-        // Verify the target is active before removing
-        if (!target->isActive())
-        {
-            throw InvalidOperation("Cannot coup an inactive player");
-        }
-        
-        // Prevent self-coup
-        if (this == target.get())
+        ActionStatus status = validateCoup(target);
+        if (status != ActionStatus::OK)
         {
-            throw InvalidOperation("You cannot coup yourself");
+            return status;
         }
 
         // Pay for the coup action
-        removeCoins(7);
+        removeCoins(game_.rules().coupCost);
 
         // Mark the target as inactive
-        target->setActive(false);
+        target.setActive(false);
 
         // Record the action and target
-        last_action_ = "coup";
-        last_target_ = target->name();
+        recordAction(ActionType::COUP, &target);
 
         game_.advanceTurn(); // Move to the next player's turn
         
         // Update the game's record of the last player to be couped
-        game_.getLastPlayerCouped() = target;
+        game_.setLastCoupedSeat(target.seat_);
+        return ActionStatus::OK;
+    }
+
+    /**
+     * Coup action through a handle
+     * @param target Handle of the player being eliminated
+     * @return ActionStatus::OK, INVALID_TARGET if the handle is stale, or the rule that forbids the action
+     */
+    ActionStatus Player::tryCoup(PlayerHandle target)
+    {
+        Player *player = game_.resolve(target);
+        return player ? tryCoup(*player) : ActionStatus::INVALID_TARGET;
+    }
+
+    /**
+     * Invest action - pay the rules' investCost and receive investReturn
+     * Available to roles whose RoleRules allow it (the Baron in the standard rules)
+     * @return ActionStatus::OK or the rule that forbids the action
+     */
+    ActionStatus Player::tryInvest()
+    {
+        ActionStatus status = validateInvest();
+        if (status != ActionStatus::OK)
+        {
+            return status;
+        }
+
+        removeCoins(game_.rules().investCost); // Pay investCost for the investment
+        addCoins(game_.rules().investReturn); // Receive investReturn back
+        recordAction(ActionType::INVEST); // Record the action taken (no target)
+
+        game_.advanceTurn(); // Move to the next player's turn
+        return ActionStatus::OK;
+    }
+
+    /**
+     * Coins the player receives from the bank when the turn changes
+     * @return 1 if the player has more coins than the role's incomeAbove, 0 otherwise
+     */
+    int Player::turnIncome() const
+    {
+        return coins() > game_.rules().role(role()).incomeAbove ? 1 : 0;
+    }
+
+    /**
+     * Response to being arrested: pays the role's arrestBankFee to the bank if
+     * the player has it (the Merchant in the standard rules)
+     */
+    void Player::react_to_arrest()
+    {
+        int fine = game_.rules().role(role()).arrestBankFee;
+        if (fine > 0 && coins() >= fine)
+        {
+            removeCoins(fine); // Remove the fine from the player
+            game_.addCoinsToBank(fine); // Add the fine to the game's bank
+        }
+    }
+
+    /**
+     * Response to being sanctioned: receives the role's sanctionRefund
+     * (the Baron in the standard rules)
+     */
+    void Player::react_to_sanction()
+    {
+        int refund = game_.rules().role(role()).sanctionRefund;
+        if (refund > 0)
+        {
+            addCoins(refund);
+        }
+    }
+
+    /**
+     * Extra coins a player pays to the bank for sanctioning this player
+     * @return The role's sanctionPenalty (the Judge's 1 coin in the standard rules)
+     */
+    int Player::sanctionPenalty() const
+    {
+        return game_.rules().role(role()).sanctionPenalty;
     }
-}
\ No newline at end of file
+}
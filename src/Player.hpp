@@ -8,8 +8,13 @@
 
 #pragma once  // Ensure this header is only included once during compilation
 #include <string>   // For string manipulation
+#include <string_view>  // For display names without copies
 #include <memory>   // For smart pointers (shared_ptr)
+#include <array>    // For the per-seat arrays
 #include "GameExceptions.hpp"  // For game-specific exceptions
+#include "Action.hpp"          // For ActionType and actionName
+#include "GameState.hpp"       // For NO_SEAT and NO_ACTION
+#include "Zobrist.hpp"         // For the incremental position hash
 using namespace std;  // Using the standard namespace
 
 namespace coup
@@ -21,7 +26,7 @@ namespace coup
      * @enum Role
      * @brief Defines the possible character roles in the game
      */
-    enum class Role 
+    enum class Role : uint8_t
     {
         GENERAL,   // Military leader role
         GOVERNOR,  // Political leader role
@@ -45,6 +50,53 @@ namespace coup
         COUP       // Eliminating another player
     };
 
+    /**
+     * @struct PlayerHandle
+     * @brief Non-owning reference to a player: a seat and the generation of the player in it
+     *
+     * Handles are plain values, so passing and storing them costs no reference
+     * counting. Every player that takes a seat gets a new generation, so a
+     * handle to a player that has been replaced (see Game::reset) no longer
+     * matches its seat and Game::resolve reports it as stale.
+     */
+    struct PlayerHandle
+    {
+        uint8_t seat = NO_SEAT;   // The player's seat, or NO_SEAT for no player
+        uint16_t generation = 0;  // Generation of the seat when the handle was made (0 for no player)
+
+        /**
+         * @brief Checks if the handle refers to a player (it may still be stale)
+         * @return True unless this is the empty handle
+         */
+        explicit operator bool() const { return seat != NO_SEAT; }
+
+        bool operator==(const PlayerHandle &other) const { return seat == other.seat && generation == other.generation; }
+        bool operator!=(const PlayerHandle &other) const { return !(*this == other); }
+    };
+
+    /**
+     * @struct PlayerTable
+     * @brief The changing state of every seat, stored as parallel arrays (owned by Game)
+     *
+     * Each field of all players is contiguous and the whole table fills one
+     * cache line, so scans over the players (game-over checks, target
+     * selection, snapshots) do not visit one heap object per player.
+     * Player objects are handles onto one seat of the table.
+     */
+    struct alignas(64) PlayerTable
+    {
+        array<int32_t, GameState::MAX_PLAYERS> coins{};       // Coin count of each seat
+        array<Role, GameState::MAX_PLAYERS> roles{};          // Role of each seat
+        array<uint8_t, GameState::MAX_PLAYERS> lastAction{};  // ActionType code of each seat's last action, or NO_ACTION
+        array<uint8_t, GameState::MAX_PLAYERS> lastTarget{};  // Seat of each last action's target, or NO_SEAT
+        array<uint16_t, GameState::MAX_PLAYERS> generation{}; // Number of players that have taken each seat
+        uint32_t active = 0;           // Bit i is set while seat i is in the game
+        uint8_t activeCount = 0;       // Number of active seats
+        uint8_t blockedEconomic = 0;   // Bit i is set while seat i is blocked from gather and tax
+        uint8_t blockedArrest = 0;     // Bit i is set while seat i is blocked from arresting
+    };
+    static_assert(sizeof(PlayerTable) == 64, "The player table must fill one cache line");
+
     /**
      * @class Player
      * @brief Base class for all player types in the Coup game
@@ -56,13 +108,50 @@ namespace coup
     protected:
         Game &game_;                   // Reference to the game instance
         string name_;                  // Player's name
-        int coins_;                    // Player's coin count
-        bool active_;                  // Whether player is active in the game
-        bool blocked_from_economic_;   // Whether player is blocked from economic actions
-        bool blocked_from_arresting_;  // Whether player is blocked from arresting
-        string last_action_;           // Player's most recent action
-        string last_target_;           // Target of player's most recent action
-        Role role_;                    // Player's role in the game
+        PlayerTable *table_;           // The game's player table that holds this player's state
+        uint8_t seat_;                 // Player's seat (index into the table)
+        uint64_t *hash_;               // Hash of the game this player belongs to
+
+        /**
+         * @brief Checks this player's bit of a per-seat bitset
+         * @param mask The bitset
+         * @return True if the bit is set
+         */
+        bool seatBit(uint32_t mask) const { return (mask >> seat_) & 1u; }
+
+        /**
+         * @brief Sets or clears this player's bit of a per-seat bitset
+         * @param mask The bitset
+         * @param value The new bit
+         */
+        void setSeatBit(uint8_t &mask, bool value)
+        {
+            mask = static_cast<uint8_t>(value ? mask | (1u << seat_) : mask & ~(1u << seat_));
+        }
+
+        /**
+         * @brief Updates the game's hash for one of this player's fields
+         * @param field The field that changes
+         * @param before The old value
+         * @param after The new value
+         */
+        void rehash(ZobristField field, int64_t before, int64_t after)
+        {
+            *hash_ ^= zobristDelta(field, seat_, before, after);
+        }
+
+        /**
+         * @brief Records the player's last action and its target
+         * @param type The action performed
+         * @param target The target of the action, or nullptr for untargeted actions
+         */
+        void recordAction(ActionType type, const Player *target = nullptr)
+        {
+            setLastAction(static_cast<uint8_t>(type), target);
+        }
+
+        friend class Game;  // Seats players and restores their state
+
     public:
         /**
          * @brief Constructor for Player
@@ -77,7 +166,7 @@ namespace coup
          */
         virtual ~Player() = default;
 
-        // Basic game action functions
+        // Basic game action functions - throw the matching GameException if the action is not allowed
         /**
          * @brief Collect one coin from the treasury
          */
@@ -86,51 +175,161 @@ namespace coup
         /**
          * @brief Collect taxes (role-specific implementation)
          */
-        virtual void tax();
+        void tax();
         
         /**
          * @brief Attempt to bribe another player (role-specific)
          */
-        virtual void bribe();
+        void bribe();
         
         /**
          * @brief Arrest another player (role-specific)
          * @param player Pointer to the player being arrested
          */
-        virtual void arrest(shared_ptr<Player> &player);
+        void arrest(shared_ptr<Player> &player);
+
+        /**
+         * @brief Arrest another player
+         * @param player Handle of the player being arrested
+         */
+        void arrest(PlayerHandle player) { throwIfFailed(tryArrest(player)); }
         
         /**
          * @brief Impose sanctions on another player (role-specific)
          * @param player Reference to the player being sanctioned
          */
-        virtual void sanction(Player &player);
+        void sanction(Player &player);
+
+        /**
+         * @brief Impose sanctions on another player
+         * @param player Handle of the player being sanctioned
+         */
+        void sanction(PlayerHandle player) { throwIfFailed(trySanction(player)); }
         
         /**
          * @brief Eliminate another player from the game
          * @param player Pointer to the player being eliminated
          */
         void coup(shared_ptr<Player> &player);
+
+        /**
+         * @brief Eliminate another player from the game
+         * @param player Handle of the player being eliminated
+         */
+        void coup(PlayerHandle player) { throwIfFailed(tryCoup(player)); }
+
+        // Non-throwing actions - perform the action and return OK, or change nothing and return the reason
+        /**
+         * @brief Collect one coin from the treasury
+         * @return ActionStatus::OK or the rule that forbids the action
+         */
+        ActionStatus tryGather();
+
+        /**
+         * @brief Collect taxes (role-specific implementation)
+         * @return ActionStatus::OK or the rule that forbids the action
+         */
+        virtual ActionStatus tryTax();
+
+        /**
+         * @brief Pay 4 coins for an extra action
+         * @return ActionStatus::OK or the rule that forbids the action
+         */
+        ActionStatus tryBribe();
+
+        /**
+         * @brief Arrest another player
+         * @param player The player being arrested
+         * @return ActionStatus::OK or the rule that forbids the action
+         */
+        ActionStatus tryArrest(Player &player);
+
+        /**
+         * @brief Arrest another player
+         * @param player Pointer to the player being arrested
+         * @return ActionStatus::OK or the rule that forbids the action
+         */
+        ActionStatus tryArrest(shared_ptr<Player> &player) { return tryArrest(*player); }
+
+        /**
+         * @brief Arrest another player
+         * @param player Handle of the player being arrested
+         * @return ActionStatus::OK, INVALID_TARGET if the handle is stale, or the rule that forbids the action
+         */
+        ActionStatus tryArrest(PlayerHandle player);
+
+        /**
+         * @brief Impose sanctions on another player
+         * @param player Reference to the player being sanctioned
+         * @return ActionStatus::OK or the rule that forbids the action
+         */
+        ActionStatus trySanction(Player &player);
+
+        /**
+         * @brief Impose sanctions on another player
+         * @param player Handle of the player being sanctioned
+         * @return ActionStatus::OK, INVALID_TARGET if the handle is stale, or the rule that forbids the action
+         */
+        ActionStatus trySanction(PlayerHandle player);
+
+        /**
+         * @brief Eliminate another player from the game
+         * @param player The player being eliminated
+         * @return ActionStatus::OK or the rule that forbids the action
+         */
+        ActionStatus tryCoup(Player &player);
+
+        /**
+         * @brief Eliminate another player from the game
+         * @param player Pointer to the player being eliminated
+         * @return ActionStatus::OK or the rule that forbids the action
+         */
+        ActionStatus tryCoup(shared_ptr<Player> &player) { return tryCoup(*player); }
+
+        /**
+         * @brief Eliminate another player from the game
+         * @param player Handle of the player being eliminated
+         * @return ActionStatus::OK, INVALID_TARGET if the handle is stale, or the rule that forbids the action
+         */
+        ActionStatus tryCoup(PlayerHandle player);
+
+        /**
+         * @brief Invest the rules' investCost for investReturn (roles whose RoleRules allow it)
+         * @return ActionStatus::OK or the rule that forbids the action
+         */
+        virtual ActionStatus tryInvest();
+
+        /**
+         * @brief Undo a previous action (role-specific)
+         * @param action The action to undo
+         * @return ActionStatus::OK or the rule that forbids the undo
+         */
+        virtual ActionStatus tryUndo(UndoableAction action) { return validateUndo(action); }
         
         /**
-         * @brief Special income at the start of a turn (role-specific)
+         * @brief Coins the player receives from the bank when the turn changes (role-specific)
+         * One coin when the player has more coins than the role's incomeAbove
+         * @return Number of coins the player is eligible for right now (0 for most roles)
          */
-        virtual void newTurnIncome() { throw InvalidOperation("Player doesn't have new turn income"); }
+        virtual int turnIncome() const;
         
         /**
          * @brief Response when player is arrested (role-specific)
+         * Pays the role's arrestBankFee to the bank if the player has it
          */
-        virtual void react_to_arrest() {}
+        virtual void react_to_arrest();
         
         /**
          * @brief Response when player is sanctioned (role-specific)
+         * Receives the role's sanctionRefund
          */
-        virtual void react_to_sanction() {}
+        virtual void react_to_sanction();
         
         /**
          * @brief Undo a previous action (role-specific)
          * @param action The action to undo
          */
-        virtual void undo(UndoableAction action) { throw InvalidOperation("Player doesn't have undo function"); }
+        void undo(UndoableAction action) { throwIfFailed(tryUndo(action)); }
         
         /**
          * @brief View another player's coins (role-specific)
@@ -142,7 +341,75 @@ namespace coup
         /**
          * @brief Make an investment (role-specific)
          */
-        virtual void invest() { throw InvalidOperation("Player doesn't have invest function"); }
+        void invest() { throwIfFailed(tryInvest()); }
+
+        /**
+         * @brief Extra coins a player pays to the bank for sanctioning this player (role-specific)
+         * @return The role's sanctionPenalty (0 for most roles)
+         */
+        virtual int sanctionPenalty() const;
+
+        // Rule checks - the same rules the action methods enforce, reported without throwing
+        /**
+         * @brief Check whether it is this player's turn and they are active
+         * @return ActionStatus::OK or the reason the player cannot act
+         */
+        ActionStatus validateTurn() const;
+
+        /**
+         * @brief Check whether gather is allowed
+         * @return ActionStatus::OK or the rule that forbids it
+         */
+        ActionStatus validateGather() const;
+
+        /**
+         * @brief Check whether tax is allowed (role-specific)
+         * The rules of gather, or for a role with taxChecksBlockFirst only the
+         * sanction and the coup rule, in that order
+         * @return ActionStatus::OK or the rule that forbids it
+         */
+        virtual ActionStatus validateTax() const;
+
+        /**
+         * @brief Check whether bribe is allowed
+         * @return ActionStatus::OK or the rule that forbids it
+         */
+        ActionStatus validateBribe() const;
+
+        /**
+         * @brief Check whether arresting a target is allowed
+         * @param target The player to arrest
+         * @return ActionStatus::OK or the rule that forbids it
+         */
+        ActionStatus validateArrest(const Player &target) const;
+
+        /**
+         * @brief Check whether sanctioning a target is allowed
+         * @param target The player to sanction
+         * @return ActionStatus::OK or the rule that forbids it
+         */
+        ActionStatus validateSanction(const Player &target) const;
+
+        /**
+         * @brief Check whether a coup against a target is allowed
+         * @param target The player to eliminate
+         * @return ActionStatus::OK or the rule that forbids it
+         */
+        ActionStatus validateCoup(const Player &target) const;
+
+        /**
+         * @brief Check whether invest is allowed (role-specific)
+         * @return ActionStatus::NOT_SUPPORTED if the role's RoleRules has no invest action,
+         *         ActionStatus::NOT_ENOUGH_COINS below the rules' investCost, ActionStatus::OK otherwise
+         */
+        virtual ActionStatus validateInvest() const;
+
+        /**
+         * @brief Check whether an action can be undone by this player (role-specific)
+         * @param action The action to undo
+         * @return ActionStatus::OK or the rule that forbids it
+         */
+        virtual ActionStatus validateUndo(UndoableAction action) const { return ActionStatus::NOT_SUPPORTED; }
 
         // Information accessor methods
         /**
@@ -151,20 +418,24 @@ namespace coup
          */
         int coins() const
         {
-            return coins_;
+            return table_->coins[seat_];
         }
         
         /**
          * @brief Set the player's coin count
          * @param amount The new coin amount
          */
-        void setCoins(int amount) { coins_ = amount; }
+        void setCoins(int amount)
+        {
+            rehash(ZobristField::COINS, coins(), amount);
+            table_->coins[seat_] = amount;
+        }
         
         /**
          * @brief Get the player's name
-         * @return Player's name as a string
+         * @return Reference to the player's name
          */
-        string name() const
+        const string &name() const
         {
             return name_;
         }
@@ -175,38 +446,36 @@ namespace coup
          */
         bool isActive() const
         {
-            return active_;
+            return seatBit(table_->active);
         }
         
         /**
          * @brief Check if player is blocked from economic actions
          * @return True if blocked, false otherwise
          */
-        bool blocked_from_economic() const { return blocked_from_economic_; }
+        bool blocked_from_economic() const { return seatBit(table_->blockedEconomic); }
         
         /**
-         * @brief Get reference to the arrest blocking status
-         * @return Reference to the blocked_from_arresting_ flag
+         * @brief Check if player is blocked from arresting
+         * @return True if blocked, false otherwise
          */
-        bool& get_blocked_from_arresting() { return blocked_from_arresting_; }
+        bool blocked_from_arresting() const { return seatBit(table_->blockedArrest); }
         
         /**
-         * @brief Get the player's last action
-         * @return Reference to the last action string
+         * @brief Get the name of the player's last action (for display)
+         * @return The action name ("gather", "tax", ...), or an empty view if there is none
          */
-        string &get_last_action()
+        string_view get_last_action() const
         {
-            return last_action_;
+            uint8_t code = lastActionCode();
+            return code == NO_ACTION ? string_view() : actionName(static_cast<ActionType>(code));
         }
         
         /**
-         * @brief Get the target of the player's last action
-         * @return Reference to the last target string
+         * @brief Get the name of the target of the player's last action (for display)
+         * @return The target's name, or an empty view if the action had no target
          */
-        string &get_last_target()
-        {
-            return last_target_;
-        }
+        string_view get_last_target() const;
 
         /**
          * @brief Get the player's role
@@ -214,9 +483,40 @@ namespace coup
          */
         Role role() const
         {
-            return role_;
+            return table_->roles[seat_];
         }
 
+        /**
+         * @brief Get the player's seat in the game
+         * @return The seat index (order in which players were created)
+         */
+        uint8_t seat() const { return seat_; }
+
+        /**
+         * @brief Get a handle to the player
+         * @return The player's seat and generation
+         */
+        PlayerHandle handle() const { return {seat_, table_->generation[seat_]}; }
+
+        /**
+         * @brief Get the player's last action as a code
+         * @return The ActionType value of the last action, or NO_ACTION
+         */
+        uint8_t lastActionCode() const { return table_->lastAction[seat_]; }
+
+        /**
+         * @brief Check the type of the player's last action
+         * @param type The action type
+         * @return True if the last action was of that type
+         */
+        bool lastActionIs(ActionType type) const { return lastActionCode() == static_cast<uint8_t>(type); }
+
+        /**
+         * @brief Get the seat of the last action's target
+         * @return The target seat, or NO_SEAT
+         */
+        uint8_t lastTargetSeat() const { return table_->lastTarget[seat_]; }
+
         // Internal utility functions
         /**
          * @brief Set whether the player is blocked from economic actions
@@ -224,23 +524,47 @@ namespace coup
          */
         void setBlockedFromEconomic(bool blocked)
         {
-            blocked_from_economic_ = blocked;
+            rehash(ZobristField::BLOCKED_ECONOMIC, blocked_from_economic(), blocked);
+            setSeatBit(table_->blockedEconomic, blocked);
+        }
+
+        /**
+         * @brief Set whether the player is blocked from arresting
+         * @param blocked True to block, false to unblock
+         */
+        void setBlockedFromArresting(bool blocked)
+        {
+            rehash(ZobristField::BLOCKED_ARREST, blocked_from_arresting(), blocked);
+            setSeatBit(table_->blockedArrest, blocked);
         }
         
         /**
          * @brief Set whether the player is active in the game
+         * Also updates the game's active count
          * @param active True for active, false for inactive
          */
-        void setActive(bool active){
-            active_ = active;
-        }
+        void setActive(bool active);
         
         /**
          * @brief Add coins to the player
          * @param amount Number of coins to add
          */
         void addCoins(int amount){
-            coins_ += amount;
+            setCoins(coins() + amount);
+        }
+
+        /**
+         * @brief Set the player's last action and its target
+         * @param action ActionType code of the action, or NO_ACTION to clear it
+         * @param target The target of the action, or nullptr for none
+         */
+        void setLastAction(uint8_t action, const Player *target)
+        {
+            uint8_t targetSeat = target ? target->seat_ : NO_SEAT;
+            rehash(ZobristField::LAST_ACTION, lastActionCode(), action);
+            rehash(ZobristField::LAST_TARGET, lastTargetSeat(), targetSeat);
+            table_->lastAction[seat_] = action;
+            table_->lastTarget[seat_] = targetSeat;
         }
         
         /**
@@ -249,11 +573,11 @@ namespace coup
          * @throws NotEnoughCoins if player has insufficient funds
          */
         void removeCoins(int amount){
-            if (coins_ < amount)
+            if (coins() < amount)
             {
                 throw NotEnoughCoins("You do not have enough coins to remove");
             }
-            coins_ -= amount;
+            setCoins(coins() - amount);
         }
 
         // Validation functions
@@ -270,16 +594,24 @@ namespace coup
          */
         void checkCoins(int amount) const
         {
-            if (coins_ < amount)
+            if (coins() < amount)
             {
                 throw NotEnoughCoins("You do not have enough coins to perform this action");
             }
         }
         
         /**
-         * @brief Check if player must perform a coup (has 10+ coins)
+         * @brief Check if player must perform a coup (holds at least mustCoupCoins coins)
          * @return True if player must coup, false otherwise
          */
-        bool mustPerformCoup() const { return coins_ >= 10; }
+        bool mustPerformCoup() const;
+
+        /**
+         * @brief Check if arresting a player moves a coin from them to the arrester
+         * Read from the target role's arrestTakesCoin (Generals and Merchants are immune in the standard rules)
+         * @param target The arrested player
+         * @return True if the target pays one coin to the arrester
+         */
+        bool arrestTakesCoin(const Player &target) const;
     };
 }
\ No newline at end of file
@@ -0,0 +1,221 @@
+//orel8155@gmail.com
+/**
+ * @file Rng.hpp
+ * @brief Small, fast, splittable random number generator for simulations
+ *
+ * Xoshiro256 is the xoshiro256** generator: 32 bytes of state, a handful of
+ * shifts and multiplies per number and a period of 2^256 - 1. Streams are
+ * split two ways:
+ * - By (seed, stream) pair: the state is filled by SplitMix64 from the seed
+ *   mixed with the stream index, so game i of a batch is reproducible from
+ *   (master seed, i) in O(1), whichever thread plays it.
+ * - By jump-ahead: jump() advances the state by 2^128 numbers and longJump()
+ *   by 2^192, so copies of one stream that are jumped 0, 1, 2, ... times
+ *   never overlap (used for the threads of one search).
+ *
+ * below() and chance() sample without distribution objects: below() uses
+ * Lemire's multiply-and-shift method, which is unbiased and only divides in
+ * the rare case that a number must be rejected.
+ *
+ * The engine uses the Rng alias, so another generator with the same members
+ * can be plugged in by changing that one line.
+ */
+#pragma once  // Ensures this header file is included only once during compilation
+
+#include <cstdint>  // For fixed-width integers
+#include <cstddef>  // For size_t
+#include <limits>   // For numeric_limits
+using namespace std; // Using standard namespace
+
+namespace coup
+{
+    /**
+     * Xoshiro256 class - the xoshiro256** generator with seeding by stream and jump-ahead
+     * Meets the UniformRandomBitGenerator requirements, so it also works with <random> and <algorithm>
+     */
+    class Xoshiro256
+    {
+    public:
+        using result_type = uint64_t;  // Type of the generated numbers
+
+        /**
+         * Constructor - seeds the generator
+         * @param seed The seed
+         * @param stream Index of the stream of the seed (e.g. the game index)
+         */
+        explicit Xoshiro256(uint64_t seed = 0, uint64_t stream = 0) { this->seed(seed, stream); }
+
+        /**
+         * Restarts the generator on a stream of a seed
+         * Different (seed, stream) pairs give unrelated sequences
+         * @param seed The seed
+         * @param stream Index of the stream of the seed
+         */
+        void seed(uint64_t seed, uint64_t stream = 0)
+        {
+            uint64_t x = seed ^ mix(stream + 0x632BE59BD9B4E019ull);
+            for (uint64_t &word : state_)
+            {
+                word = splitMix(x);
+            }
+        }
+
+        /**
+         * Smallest value operator() returns
+         * @return 0
+         */
+        static constexpr result_type min() { return 0; }
+
+        /**
+         * Largest value operator() returns
+         * @return 2^64 - 1
+         */
+        static constexpr result_type max() { return numeric_limits<result_type>::max(); }
+
+        /**
+         * Generates the next number
+         * @return 64 random bits
+         */
+        result_type operator()()
+        {
+            uint64_t result = rotl(state_[1] * 5, 7) * 9;
+            uint64_t t = state_[1] << 17;
+            state_[2] ^= state_[0];
+            state_[3] ^= state_[1];
+            state_[1] ^= state_[2];
+            state_[0] ^= state_[3];
+            state_[2] ^= t;
+            state_[3] = rotl(state_[3], 45);
+            return result;
+        }
+
+        /**
+         * Draws a number uniformly from [0, bound)
+         * @param bound The number of values (must be at least 1)
+         * @return The number
+         */
+        uint32_t below(uint32_t bound)
+        {
+            uint64_t product = static_cast<uint64_t>(static_cast<uint32_t>((*this)() >> 32)) * bound;
+            uint32_t low = static_cast<uint32_t>(product);
+            if (low < bound)
+            {
+                uint32_t threshold = static_cast<uint32_t>(-bound) % bound;  // 2^32 mod bound
+                while (low < threshold)
+                {
+                    product = static_cast<uint64_t>(static_cast<uint32_t>((*this)() >> 32)) * bound;
+                    low = static_cast<uint32_t>(product);
+                }
+            }
+            return static_cast<uint32_t>(product >> 32);
+        }
+
+        /**
+         * Draws a number uniformly from [0, 1)
+         * @return The number (53 random bits)
+         */
+        double uniform() { return ((*this)() >> 11) * 0x1.0p-53; }
+
+        /**
+         * Draws true with a probability
+         * @param probability Probability of true
+         * @return The draw
+         */
+        bool chance(double probability) { return uniform() < probability; }
+
+        /**
+         * Advances the generator by 2^128 numbers
+         * Jumping copies of one generator 0, 1, 2, ... times gives 2^128 non-overlapping streams
+         */
+        void jump()
+        {
+            static constexpr uint64_t JUMP[] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                                0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+            advance(JUMP);
+        }
+
+        /**
+         * Advances the generator by 2^192 numbers
+         * Each long jump starts a block of 2^64 streams that jump() can split further
+         */
+        void longJump()
+        {
+            static constexpr uint64_t LONG_JUMP[] = {0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull,
+                                                     0x77710069854EE241ull, 0x39109BB02ACBE635ull};
+            advance(LONG_JUMP);
+        }
+
+        bool operator==(const Xoshiro256 &other) const
+        {
+            return state_[0] == other.state_[0] && state_[1] == other.state_[1] && state_[2] == other.state_[2] &&
+                   state_[3] == other.state_[3];
+        }
+        bool operator!=(const Xoshiro256 &other) const { return !(*this == other); }
+
+    private:
+        uint64_t state_[4];  // Generator state (never all zero)
+
+        /**
+         * Rotates bits to the left
+         * @param x The value
+         * @param k Number of bits
+         * @return The rotated value
+         */
+        static constexpr uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+        /**
+         * Scrambles a 64-bit value (the SplitMix64 finalizer)
+         * @param z The value
+         * @return The scrambled value
+         */
+        static constexpr uint64_t mix(uint64_t z)
+        {
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        /**
+         * Steps a SplitMix64 generator
+         * @param x The SplitMix64 state
+         * @return The next SplitMix64 number
+         */
+        static uint64_t splitMix(uint64_t &x)
+        {
+            x += 0x9E3779B97F4A7C15ull;
+            return mix(x);
+        }
+
+        /**
+         * Advances the generator by the jump polynomial given by its coefficients
+         * @param coefficients The jump polynomial
+         */
+        void advance(const uint64_t (&coefficients)[4])
+        {
+            uint64_t next[4] = {0, 0, 0, 0};
+            for (uint64_t word : coefficients)
+            {
+                for (int bit = 0; bit < 64; ++bit)
+                {
+                    if (word & (1ull << bit))
+                    {
+                        for (int i = 0; i < 4; ++i)
+                        {
+                            next[i] ^= state_[i];
+                        }
+                    }
+                    (*this)();
+                }
+            }
+            for (int i = 0; i < 4; ++i)
+            {
+                state_[i] = next[i];
+            }
+        }
+    };
+
+    /**
+     * Random number generator of the simulator and the bot
+     */
+    using Rng = Xoshiro256;
+}
@@ -0,0 +1,77 @@
+//orel8155@gmail.com
+/**
+ * @file RoleRules.hpp
+ * @brief Compile-time table of what each role changes about the basic rules
+ *
+ * The role differences that are plain numbers and switches (tax, invest,
+ * arrest and sanction reactions, turn income) are written down here per
+ * role. Game::applyStatic looks them up by Role so the compiler can inline
+ * the effects into the action code, and the virtual path (Player::tryTax,
+ * react_to_arrest, turnIncome, ...) reads the same entries from the game's
+ * RuleConfig, so both paths agree for any rule values; the tests play the
+ * same games through both paths and compare every state.
+ */
+#pragma once  // Ensures this header file is included only once during compilation
+
+#include "Player.hpp"  // For Role
+#include <array>       // For the per-role table
+#include <cstdint>     // For fixed-width integers
+
+namespace coup
+{
+    /**
+     * @struct RoleRules
+     * @brief How one role differs from the basic rules
+     */
+    struct RoleRules
+    {
+        int8_t taxGain;           // Coins the player gains by tax
+        int8_t taxBankCost;       // Coins tax takes from the bank
+        bool taxChecksBlockFirst; // Tax reports a sanction before the 10-coin rule and skips the turn check (Governor)
+        bool canInvest;           // The role has the invest action (Baron)
+        bool arrestTakesCoin;     // Arresting the role moves one of its coins to the arrester
+        int8_t arrestBankFee;     // Coins the role pays to the bank when arrested, if it has them (Merchant)
+        int8_t sanctionRefund;    // Coins the role receives when sanctioned (Baron)
+        int8_t sanctionPenalty;   // Extra coins a sanction against the role costs (Judge)
+        int8_t incomeAbove;       // The role earns one coin at the end of its turn when it has more coins than this
+    };
+
+    /**
+     * Never reached by incomeAbove (the role has no turn income)
+     */
+    constexpr int8_t NO_INCOME = INT8_MAX;
+
+    /**
+     * The rules of each role, indexed by Role
+     */
+    constexpr array<RoleRules, 6> ROLE_RULES = {{
+        // gain  bank  blockFirst invest takesCoin fee  refund penalty income
+        {2, 2, false, false, false, 0, 0, 0, NO_INCOME},  // General
+        {3, 0, true, false, true, 0, 0, 0, NO_INCOME},    // Governor
+        {2, 2, false, false, true, 0, 0, 0, NO_INCOME},   // Spy
+        {2, 2, false, true, true, 0, 1, 0, NO_INCOME},    // Baron
+        {2, 2, false, false, true, 0, 0, 1, NO_INCOME},   // Judge
+        {2, 2, false, false, false, 2, 0, 0, 3},          // Merchant
+    }};
+
+    /**
+     * Gets the rules of a role
+     * @param role The role
+     * @return The role's entry of ROLE_RULES
+     */
+    constexpr const RoleRules &roleRules(Role role)
+    {
+        return ROLE_RULES[static_cast<size_t>(role)];
+    }
+
+    /**
+     * Gets the coins a role earns at the end of its turn
+     * @param role The role
+     * @param coins The player's coins
+     * @return The turn income
+     */
+    constexpr int roleTurnIncome(Role role, int coins)
+    {
+        return coins > roleRules(role).incomeAbove ? 1 : 0;
+    }
+}
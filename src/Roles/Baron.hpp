@@ -12,8 +12,10 @@ namespace coup
      * - Can invest coins to gain more coins
      * - Has a unique reaction to economic sanctions
      * 
-     * This class inherits from the base Player class and overrides
-     * specific methods to implement the Baron's special abilities.
+     * Both abilities are described by the Baron's RoleRules entry (canInvest,
+     * sanctionRefund) and carried out by Player::tryInvest and
+     * Player::react_to_sanction, which read it from the game's rules, so the
+     * rule values of a game apply to the Baron like to every other role.
      */
     class Baron : public Player
     {
@@ -32,23 +34,5 @@ namespace coup
          * Uses the default implementation
          */
         ~Baron() override = default;
-
-        /**
-         * @brief Performs the Baron's special investment action
-         * 
-         * Allows the Baron to invest coins and receive more in return,
-         * effectively generating profit. This is a unique ability
-         * that only the Baron role can perform.
-         */
-        void invest() override;
-
-        /**
-         * @brief Defines how the Baron reacts to economic sanctions
-         * 
-         * Due to the Baron's economic influence, they react differently
-         * to sanctions compared to other roles. This method implements
-         * that special reaction.
-         */
-        void react_to_sanction() override;
     };
-}
\ No newline at end of file
+}
@@ -18,35 +18,26 @@ namespace coup
     /**
      * @brief Blocks a coup action performed by another player
      * 
-     * This method allows the General to prevent a coup by paying 5 coins.
+     * This method allows the General to prevent a coup by paying the rules' coupBlockCost
+     * (5 coins in the standard rules).
      * It returns the eliminated player back to the game.
      * 
+     * The caller must have checked the action with validateUndo(UndoableAction::COUP).
+     * 
      * @param target The player who performed the coup action to be blocked
-     * @throws InsufficientCoins if the General doesn't have 5 coins
-     * @throws InvalidOperation if there's no player to restore
      */
     void General::block_coup(Player &target)
     {
-        // Check if the General has enough coins (5) to perform this action
-        checkCoins(5);
-
         // Remove the coins from the General's holdings after confirming the action is valid
-        removeCoins(5);
+        removeCoins(game_.rules().coupBlockCost);
 
         // Find the player who was last eliminated by a coup and return them to the game
-        auto victim = game_.getLastPlayerCouped();
-        if (victim)
-        {
-            // Set the eliminated player back to active status
-            victim->setActive(true);
-            // Clear the arrested player reference in the game state
-            game_.getArrestedPlayer() = nullptr;
-        }
-        else
-        {
-            // If no player was recently eliminated, throw an exception
-            throw InvalidOperation("General can't undo this action");
-        }
+        uint8_t victim = game_.lastCoupedSeat();
+
+        // Set the eliminated player back to active status
+        game_.getPlayers()[victim]->setActive(true);
+        // Clear the arrested player reference in the game state
+        game_.setArrestedPlayer(PlayerHandle());
     }
 
 
@@ -57,19 +48,48 @@ namespace coup
      * Currently only supports undoing coup actions.
      * 
      * @param action The type of action to undo (from UndoableAction enum)
-     * @throws InvalidOperation if the General can't undo the specified action
+     * @return ActionStatus::OK if the coup was blocked, otherwise the rule that forbids it
      */
-    void General::undo(UndoableAction action)
+    ActionStatus General::tryUndo(UndoableAction action)
     {
-        if (action == UndoableAction::COUP)
+        ActionStatus status = validateUndo(action);
+        if (status != ActionStatus::OK)
         {
-            // If the action is a coup, call block_coup to reverse it
-            block_coup(*game_.getCurrentPlayer());
+            return status;
         }
-        else
+
+        // If the action is a coup, call block_coup to reverse it
+        block_coup(game_.player(game_.currentPlayer()));
+        return ActionStatus::OK;
+    }
+
+    /**
+     * @brief Checks whether the General can undo an action right now
+     * 
+     * Blocking a coup costs coupBlockCost coins and needs a player who was eliminated by a coup.
+     * 
+     * @param action The type of action to undo (must be COUP for General)
+     * @return ActionStatus::OK or the rule that forbids the undo
+     */
+    ActionStatus General::validateUndo(UndoableAction action) const
+    {
+        // The General can only undo coups
+        if (action != UndoableAction::COUP)
+        {
+            return ActionStatus::NOT_SUPPORTED;
+        }
+
+        // Check if the General has enough coins (coupBlockCost) to perform this action
+        if (coins() < game_.rules().coupBlockCost)
+        {
+            return ActionStatus::NOT_ENOUGH_COINS;
+        }
+
+        // There must be a player who was eliminated by a coup
+        if (game_.lastCoupedSeat() == NO_SEAT)
         {
-            // If the action is not a coup, throw an exception
-            throw InvalidOperation("General can't undo this action");
+            return ActionStatus::NOTHING_TO_UNDO;
         }
+        return ActionStatus::OK;
     }
 }
@@ -52,7 +52,16 @@ namespace coup
          * types of actions that have occurred in the game.
          * 
          * @param action The type of action to undo
+         * @return ActionStatus::OK if the coup was blocked, otherwise the rule that forbids it
          */
-        void undo(UndoableAction action) override;
+        ActionStatus tryUndo(UndoableAction action) override;
+
+        /**
+         * @brief Checks whether the General can undo an action right now
+         * 
+         * @param action The type of action to undo (only COUP is supported)
+         * @return ActionStatus::OK or the rule that forbids the undo
+         */
+        ActionStatus validateUndo(UndoableAction action) const override;
     };
 }
\ No newline at end of file
@@ -14,100 +14,85 @@
 namespace coup
 {
     /**
-     * @brief Performs the Governor's special tax collection action
+     * @brief Cancels taxes collected by a target player
      * 
-     * This method allows the Governor to collect 3 coins as tax.
-     * If the Governor is blocked from economic actions or has 10 or more coins,
-     * the action will fail with an appropriate exception.
+     * This method allows the Governor to cancel taxes collected by another player.
+     * The target loses the taxGain of their role (3 coins for a Governor and 2 for
+     * the others in the standard rules).
      * 
-     * @throws InvalidOperation if the Governor is blocked from economic actions
-     * @throws InvalidOperation if the Governor has 10 or more coins (must coup instead)
+     * @param target The player whose tax collection is being canceled
      */
-    void Governor::tax()
+    void Governor::cancel_taxes(Player &target)
     {
-        // Check if the Governor is currently blocked from performing economic actions
-        if (blocked_from_economic_)
-        {
-            throw InvalidOperation("Governor is blocked from economic actions");
-        }
-        // Check if the Governor has 10 or more coins, in which case they must perform a coup
-        if (coins_ >= 10){
-            throw InvalidOperation("Governor must perform a coup he has more than 10 coins");
-        }
-        
-        // Add 3 coins to the Governor's holdings as tax collection
-        addCoins(3);
-        // Record that the last action performed was 'tax'
-        last_action_ = "tax";
-        // No target for this action
-        last_target_ = "";
-
-        // End the Governor's turn and move to the next player
-        game_.advanceTurn();
+        // Remove what the target's tax gave them (their role's taxGain)
+        target.removeCoins(game_.rules().role(target.role()).taxGain);
     }
 
     /**
-     * @brief Cancels taxes collected by a target player
+     * @brief Allows the Governor to undo certain game actions
      * 
-     * This method allows the Governor to cancel taxes collected by another player.
-     * If the target is another Governor, 3 coins are removed. Otherwise, 2 coins are removed.
+     * This method gives the Governor the ability to undo tax actions performed by
+     * the previous player. It verifies several conditions before allowing the undo.
      * 
-     * @param target The player whose tax collection is being canceled
+     * @param action The type of action to undo (must be TAX for Governor)
+     * @return ActionStatus::OK if the tax was cancelled, otherwise the rule that forbids it
      */
-    void Governor::cancel_taxes(Player &target)
+    ActionStatus Governor::tryUndo(UndoableAction action)
     {
-        // Check if the target player is also a Governor
-        if (target.role() == Role::GOVERNOR)
+        ActionStatus status = validateUndo(action);
+        if (status != ActionStatus::OK)
         {
-            target.removeCoins(3); // Remove 3 coins from another Governor
-        }
-        else
-        {
-            target.removeCoins(2); // Remove 2 coins from a regular player
+            return status;
         }
+
+        // Call the method to cancel taxes for the previous player
+        cancel_taxes(game_.player(game_.previousPlayer()));
+        return ActionStatus::OK;
     }
 
     /**
-     * @brief Allows the Governor to undo certain game actions
+     * @brief Checks whether the Governor can undo an action right now
      * 
-     * This method gives the Governor the ability to undo tax actions performed by
-     * the previous player. It verifies several conditions before allowing the undo.
+     * The Governor can only undo the tax collected by the previous player,
+     * never their own, and the previous player must still hold the coins.
      * 
      * @param action The type of action to undo (must be TAX for Governor)
-     * @throws InvalidOperation if conditions for undoing are not met
+     * @return ActionStatus::OK or the rule that forbids the undo
      */
-    void Governor::undo(UndoableAction action)
+    ActionStatus Governor::validateUndo(UndoableAction action) const
     {
-        // Check if the action to undo is a tax action
-        if (action == UndoableAction::TAX)
+        // The Governor can only undo tax actions
+        if (action != UndoableAction::TAX)
+        {
+            return ActionStatus::NOT_SUPPORTED;
+        }
+
+        // Get a reference to the previous player who took a turn
+        const Player *previousPlayer = game_.resolve(game_.previousPlayer());
+        // Check if there is a previous player available
+        if (!previousPlayer)
+        {
+            return ActionStatus::NOTHING_TO_UNDO;
+        }
+
+        // Important check: The Governor cannot undo their own tax action
+        if (previousPlayer->seat() == seat_)
         {
-            // Get a reference to the previous player who took a turn
-            auto &previousPlayer = game_.getPreviousPlayer();
-            // Check if there is a previous player available
-            if (!previousPlayer)
-            {
-                throw InvalidOperation("No previous player found to undo tax");
-            }
-            
-            // Important check: The Governor cannot undo their own tax action
-            if (previousPlayer->name() == name_)
-            {
-                throw InvalidOperation("Governor cannot undo his own tax action");
-            }
-            
-            // Verify that the previous player's last action was indeed a tax collection
-            if (previousPlayer->get_last_action() != "tax")
-            {
-                throw InvalidOperation("Previous player's last action was not tax");
-            }
-            
-            // Call the method to cancel taxes for the previous player
-            cancel_taxes(*previousPlayer);
+            return ActionStatus::CANNOT_UNDO_OWN;
         }
-        else
+
+        // Verify that the previous player's last action was indeed a tax collection
+        if (!previousPlayer->lastActionIs(ActionType::TAX))
+        {
+            return ActionStatus::NOTHING_TO_UNDO;
+        }
+
+        // The previous player must still have the coins the tax gave them
+        int refund = game_.rules().role(previousPlayer->role()).taxGain;
+        if (previousPlayer->coins() < refund)
         {
-            // If the action is not TAX, throw an exception as the Governor can only undo tax actions
-            throw InvalidOperation("Governor can't undo this action");
+            return ActionStatus::TARGET_CANNOT_PAY;
         }
+        return ActionStatus::OK;
     }
 }
\ No newline at end of file
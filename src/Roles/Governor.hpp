@@ -15,8 +15,9 @@ namespace coup
      * - Can cancel taxation actions performed by other players
      * - Can undo certain tax-related actions in the game
      * 
-     * This class inherits from the base Player class and overrides
-     * specific methods to implement the Governor's special abilities.
+     * The tax itself is the Player tax with the Governor's RoleRules entry
+     * (taxGain, taxBankCost, taxChecksBlockFirst). This class overrides the
+     * undo methods to implement the Governor's other abilities.
      */
     class Governor : public Player
     {
@@ -46,14 +47,6 @@ namespace coup
          */
         ~Governor() override = default;
         
-        /**
-         * @brief Performs the Governor's special tax collection action
-         * 
-         * This method allows the Governor to collect 3 coins as tax.
-         * Overrides the base class tax method with Governor-specific implementation.
-         */
-        void tax() override;
-        
         /**
          * @brief Allows the Governor to undo certain tax-related game actions
          * 
@@ -61,7 +54,16 @@ namespace coup
          * other players, canceling their effects.
          * 
          * @param action The type of action to undo (should be TAX for Governor)
+         * @return ActionStatus::OK if the tax was cancelled, otherwise the rule that forbids it
+         */
+        ActionStatus tryUndo(UndoableAction action) override;
+
+        /**
+         * @brief Checks whether the Governor can undo an action right now
+         * 
+         * @param action The type of action to undo (only TAX is supported)
+         * @return ActionStatus::OK or the rule that forbids the undo
          */
-        void undo(UndoableAction action) override;
+        ActionStatus validateUndo(UndoableAction action) const override;
     };
 }
\ No newline at end of file
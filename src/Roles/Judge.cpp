@@ -43,66 +43,75 @@ namespace coup
     }
 
     /**
-     * @brief Defines how the Judge reacts when targeted by a sanction
+     * @brief Allows the Judge to undo specific game actions
      * 
-     * This method implements the Judge's immunity to sanctions. When someone
-     * attempts to sanction a Judge, the action fails and the sanctioning player
-     * must pay 1 coin back to the bank as a penalty.
+     * This method implements the Judge's special ability to undo bribe actions.
+     * It searches for the player who performed the bribe, validates that the Judge
+     * can legitimately undo the action, and then calls cancel_bribe to reverse it.
      * 
-     * @throws InvalidOperation indicating that Judges cannot be sanctioned
+     * @param action The type of action to undo (from UndoableAction enum)
+     * @return ActionStatus::OK if the bribe was cancelled, otherwise the rule that forbids it
      */
-    void Judge::react_to_sanction()
+    ActionStatus Judge::tryUndo(UndoableAction action)
     {
-        throw InvalidOperation("Cannot sanction Judge, pay 1 coin back to the bank");
+        ActionStatus status = validateUndo(action);
+        if (status != ActionStatus::OK)
+        {
+            return status;
+        }
+
+        // Call the method to cancel the bribe for the identified player
+        cancel_bribe(game_.player(findBriber()));
+        return ActionStatus::OK;
     }
 
     /**
-     * @brief Allows the Judge to undo specific game actions
+     * @brief Finds the active player whose last action was a bribe
      * 
-     * This method implements the Judge's special ability to undo bribe actions.
-     * It searches for the player who performed the bribe, validates that the Judge
-     * can legitimately undo the action, and then calls cancel_bribe to reverse it.
+     * Searches for the player who performed a bribe instead of relying on previous_player_.
      * 
-     * @param action The type of action to undo (from UndoableAction enum)
-     * @throws InvalidOperation if the Judge cannot undo the specified action
+     * @return Handle of the first such player in seat order, or the empty handle if there is none
      */
-    void Judge::undo(UndoableAction action)
+    PlayerHandle Judge::findBriber() const
     {
-        if (action == UndoableAction::BRIBE)
+        // Iterate through the active players to find who last performed a bribe action
+        for (const auto &player : game_.activePlayers())
         {
-            
-            // Search for the player who performed a bribe instead of relying on previous_player_
-            shared_ptr<Player> briberPlayer = nullptr;
-            auto players = game_.players();
-            
-            // Iterate through all players to find who last performed a bribe action
-            for (const auto& playerName : players) {
-                auto player = game_.getPlayerByName(playerName);
-                if (player->get_last_action() == "bribe") {
-                    briberPlayer = player;
-                    break;
-                }
-            }
-            
-            // Verify that a player who performed bribe was found
-            if (!briberPlayer)
+            if (player->lastActionIs(ActionType::BRIBE))
             {
-                throw InvalidOperation("No player found who performed bribe");
+                return player->handle();
             }
-            
-            // Verify that the Judge is not trying to undo their own bribe
-            if (briberPlayer->name() == name_){
-                throw InvalidOperation("Judge cannot undo his own bribe");
-            }
-            
-            // Call the method to cancel the bribe for the identified player
-            cancel_bribe(*briberPlayer);
         }
-        else
+        return PlayerHandle();
+    }
+
+    /**
+     * @brief Checks whether the Judge can undo an action right now
+     * 
+     * @param action The type of action to undo (must be BRIBE for Judge)
+     * @return ActionStatus::OK or the rule that forbids the undo
+     */
+    ActionStatus Judge::validateUndo(UndoableAction action) const
+    {
+        // The Judge can only undo bribes
+        if (action != UndoableAction::BRIBE)
+        {
+            return ActionStatus::NOT_SUPPORTED;
+        }
+
+        // Verify that a player who performed bribe was found
+        PlayerHandle briber = findBriber();
+        if (!briber)
+        {
+            return ActionStatus::NOTHING_TO_UNDO;
+        }
+
+        // Verify that the Judge is not trying to undo their own bribe
+        if (briber.seat == seat_)
         {
-            // If the action is not a bribe, throw an exception as the Judge can only undo bribes
-            throw InvalidOperation("Judge cannot undo this action");
+            return ActionStatus::CANNOT_UNDO_OWN;
         }
+        return ActionStatus::OK;
     }
 
 }
\ No newline at end of file
@@ -21,8 +21,9 @@ namespace coup
      * - Has immunity to sanctions imposed by other players
      * - Maintains judicial authority in the game
      * 
-     * This class inherits from the base Player class and overrides
-     * specific methods to implement the Judge's special abilities.
+     * The sanction penalty is the Judge's sanctionPenalty in RoleRules, which
+     * Player reads. This class overrides the undo methods to implement the
+     * Judge's other abilities.
      */
     class Judge : public Player
     {
@@ -35,6 +36,13 @@ namespace coup
          * @param target The player whose bribe action is being canceled
          */
         void cancel_bribe(Player &target);
+
+        /**
+         * @brief Finds the active player whose last action was a bribe
+         * 
+         * @return Handle of the player, or the empty handle if no active player bribed last
+         */
+        PlayerHandle findBriber() const;
     public:
         /**
          * @brief Constructor for the Judge class
@@ -62,14 +70,6 @@ namespace coup
          */
         bool can_undo(const string &action) const;
         
-        /**
-         * @brief Defines how the Judge reacts when targeted by a sanction
-         * 
-         * This method implements the Judge's immunity to sanctions. It overrides
-         * the base class method to provide Judge-specific behavior.
-         */
-        void react_to_sanction() override;
-        
         /**
          * @brief Allows the Judge to undo specific game actions
          * 
@@ -77,7 +77,16 @@ namespace coup
          * other players, particularly bribe actions.
          * 
          * @param action The type of action to undo (from UndoableAction enum)
+         * @return ActionStatus::OK if the bribe was cancelled, otherwise the rule that forbids it
+         */
+        ActionStatus tryUndo(UndoableAction action) override;
+
+        /**
+         * @brief Checks whether the Judge can undo an action right now
+         * 
+         * @param action The type of action to undo (only BRIBE is supported)
+         * @return ActionStatus::OK or the rule that forbids the undo
          */
-        void undo(UndoableAction action) override;
+        ActionStatus validateUndo(UndoableAction action) const override;
     };
 }
\ No newline at end of file
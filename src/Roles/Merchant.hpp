@@ -20,8 +20,10 @@ namespace coup
      * - Has special reactions to being arrested
      * - Maintains economic advantages in the game
      * 
-     * This class inherits from the base Player class and overrides
-     * specific methods to implement the Merchant's special abilities.
+     * The passive income and the arrest fine are described by the Merchant's
+     * RoleRules entry (incomeAbove, arrestBankFee) and carried out by
+     * Player::turnIncome and Player::react_to_arrest, which read it from the
+     * game's rules.
      */
     class Merchant : public Player
     {
@@ -40,21 +42,5 @@ namespace coup
          * Uses the default implementation
          */
         ~Merchant() override = default;
-        
-        /**
-         * @brief Provides additional income to the Merchant at the start of their turn
-         * 
-         * This method overrides the base class method to implement the Merchant's
-         * special ability to earn passive income when they have more than 3 coins.
-         */
-        void newTurnIncome() override;
-        
-        /**
-         * @brief Defines how the Merchant reacts when arrested
-         * 
-         * This method overrides the base class method to implement the Merchant's
-         * special reaction to being arrested - paying a fine from their wealth.
-         */
-        void react_to_arrest() override;
     };
 }
\ No newline at end of file
@@ -34,7 +34,7 @@ namespace coup
          * 
          * @param target The player to block from arresting
          */
-        void block_arrest(Player &target) { target.get_blocked_from_arresting() = true; }
+        void block_arrest(Player &target) { target.setBlockedFromArresting(true); }
 
     public:
         /**
@@ -0,0 +1,186 @@
+//orel8155@gmail.com
+/**
+ * @file Rules.hpp
+ * @brief Compile-time rule set: the costs and thresholds of the game in one policy type
+ *
+ * DefaultRules holds the rules of the standard game. The engine reads its
+ * constants instead of writing the numbers out, and the rule-table path
+ * (Game::applyStatic, Game::legalActionsStatic) takes the rule set as a
+ * template parameter, so a variant is a type whose constants the compiler
+ * folds into the action code:
+ *
+ *   struct CheapCoupRules : DefaultRules
+ *   {
+ *       static constexpr int COUP_COST = 5;
+ *   };
+ *   game.applyStatic<CheapCoupRules>(action);
+ *
+ * A variant derives from DefaultRules and redeclares only what it changes.
+ * To change what the roles do, it redeclares role() with its own RoleRules table.
+ *
+ * RuleConfig holds the same values as run-time data, for sweeping them
+ * without recompiling. Every game carries one (the standard values by
+ * default); Player reads all of it (the role table included), and so does
+ * the rule-table path when instantiated with RuleConfig.
+ */
+#pragma once  // Ensures this header file is included only once during compilation
+
+#include "GameState.hpp"  // For the seat capacity
+#include "RoleRules.hpp"  // For the per-role table
+#include <array>          // For the role table of a config
+#include <cstddef>        // For size_t
+#include <cstdint>        // For fixed-width integers
+
+namespace coup
+{
+    /**
+     * @struct DefaultRules
+     * @brief The rules of the standard game
+     */
+    struct DefaultRules
+    {
+        static constexpr int COUP_COST = 7;         // Coins a coup costs
+        static constexpr int BRIBE_COST = 4;        // Coins a bribe costs
+        static constexpr int SANCTION_COST = 3;     // Coins a sanction costs before the target's penalty
+        static constexpr int MUST_COUP_COINS = 10;  // A player with this many coins must coup
+        static constexpr int INVEST_COST = 3;       // Coins the Baron pays to invest
+        static constexpr int INVEST_RETURN = 6;     // Coins the Baron receives from an investment
+        static constexpr int COUP_BLOCK_COST = 5;   // Coins the General pays to undo a coup
+        static constexpr size_t MIN_PLAYERS = 2;    // Fewest players of a game
+        static constexpr size_t MAX_PLAYERS = 6;    // Most players of a game
+
+        /**
+         * Gets how a role differs from the basic rules
+         * @param role The role
+         * @return The role's entry of ROLE_RULES
+         */
+        static constexpr const RoleRules &role(Role role) { return roleRules(role); }
+    };
+
+    static_assert(DefaultRules::MAX_PLAYERS <= GameState::MAX_PLAYERS, "A game state must hold every seat");
+
+    /**
+     * @struct RuleConfig
+     * @brief Rule values chosen at run time, for sweeping them without recompiling
+     *
+     * A game takes its RuleConfig at construction and keeps it in one 64-byte
+     * block, so the action code reads every value from a single cache line.
+     * The defaults are the values of DefaultRules. Player reads every value
+     * from the game's config, including the whole RoleRules entry of each
+     * role; the rule-table path reads it when instantiated with RuleConfig
+     * (see Game::applyRules).
+     */
+    struct alignas(64) RuleConfig
+    {
+        int8_t coupCost = DefaultRules::COUP_COST;              // Coins a coup costs
+        int8_t bribeCost = DefaultRules::BRIBE_COST;            // Coins a bribe costs
+        int8_t sanctionCost = DefaultRules::SANCTION_COST;      // Coins a sanction costs before the target's penalty
+        int8_t mustCoupCoins = DefaultRules::MUST_COUP_COINS;   // A player with this many coins must coup
+        int8_t investCost = DefaultRules::INVEST_COST;          // Coins the Baron pays to invest
+        int8_t investReturn = DefaultRules::INVEST_RETURN;      // Coins the Baron receives from an investment
+        int8_t coupBlockCost = DefaultRules::COUP_BLOCK_COST;   // Coins the General pays to undo a coup
+        array<RoleRules, 6> roles = ROLE_RULES;                 // How each role differs from the basic rules
+
+        /**
+         * Gets how a role differs from the basic rules
+         * @param role The role
+         * @return The role's entry of roles
+         */
+        const RoleRules &role(Role role) const { return roles[static_cast<size_t>(role)]; }
+
+        /**
+         * Gets a role's entry for changing it
+         * @param role The role
+         * @return The role's entry of roles
+         */
+        RoleRules &role(Role role) { return roles[static_cast<size_t>(role)]; }
+
+        /**
+         * Checks if the values make a playable game
+         * Costs and thresholds are not negative and a player who must coup can afford it
+         * @return True if the config is valid
+         */
+        bool isValid() const
+        {
+            bool ok = coupCost >= 0 && bribeCost >= 0 && sanctionCost >= 0 && investCost >= 0 &&
+                      investReturn >= 0 && coupBlockCost >= 0 && mustCoupCoins >= coupCost;
+            for (const RoleRules &rules : roles)
+            {
+                ok = ok && rules.taxGain >= 0 && rules.taxBankCost >= 0 && rules.arrestBankFee >= 0 &&
+                     rules.sanctionRefund >= 0 && rules.sanctionPenalty >= 0 && rules.incomeAbove >= 0;
+            }
+            return ok;
+        }
+
+        /**
+         * Checks if the config holds the values of DefaultRules
+         * @return True for the standard rules
+         */
+        bool isStandard() const { return *this == RuleConfig(); }
+
+        bool operator==(const RuleConfig &other) const;
+        bool operator!=(const RuleConfig &other) const { return !(*this == other); }
+    };
+    static_assert(sizeof(RuleConfig) == 64, "A rule config must fill one cache line");
+
+    /**
+     * Compares two role entries field by field
+     * @param a The first entry
+     * @param b The second entry
+     * @return True if the entries are equal
+     */
+    inline bool operator==(const RoleRules &a, const RoleRules &b)
+    {
+        return a.taxGain == b.taxGain && a.taxBankCost == b.taxBankCost && a.taxChecksBlockFirst == b.taxChecksBlockFirst &&
+               a.canInvest == b.canInvest && a.arrestTakesCoin == b.arrestTakesCoin && a.arrestBankFee == b.arrestBankFee &&
+               a.sanctionRefund == b.sanctionRefund && a.sanctionPenalty == b.sanctionPenalty && a.incomeAbove == b.incomeAbove;
+    }
+
+    /**
+     * Compares two configs value by value
+     * @param other The other config
+     * @return True if every value is equal
+     */
+    inline bool RuleConfig::operator==(const RuleConfig &other) const
+    {
+        return coupCost == other.coupCost && bribeCost == other.bribeCost && sanctionCost == other.sanctionCost &&
+               mustCoupCoins == other.mustCoupCoins && investCost == other.investCost &&
+               investReturn == other.investReturn && coupBlockCost == other.coupBlockCost && roles == other.roles;
+    }
+
+    /**
+     * RuleView - uniform access to the values of a rule set
+     * For a compile-time rule set every value is a constant the compiler
+     * folds; RuleView<RuleConfig> reads the game's config instead
+     */
+    template <class R>
+    struct RuleView
+    {
+        explicit constexpr RuleView(const RuleConfig &) {}
+        static constexpr int coupCost() { return R::COUP_COST; }
+        static constexpr int bribeCost() { return R::BRIBE_COST; }
+        static constexpr int sanctionCost() { return R::SANCTION_COST; }
+        static constexpr int mustCoupCoins() { return R::MUST_COUP_COINS; }
+        static constexpr int investCost() { return R::INVEST_COST; }
+        static constexpr int investReturn() { return R::INVEST_RETURN; }
+        static constexpr const RoleRules &role(Role role) { return R::role(role); }
+    };
+
+    /**
+     * RuleView of a run-time config
+     */
+    template <>
+    struct RuleView<RuleConfig>
+    {
+        const RuleConfig &config;  // The game's rule values
+
+        explicit RuleView(const RuleConfig &rules) : config(rules) {}
+        int coupCost() const { return config.coupCost; }
+        int bribeCost() const { return config.bribeCost; }
+        int sanctionCost() const { return config.sanctionCost; }
+        int mustCoupCoins() const { return config.mustCoupCoins; }
+        int investCost() const { return config.investCost; }
+        int investReturn() const { return config.investReturn; }
+        const RoleRules &role(Role role) const { return config.role(role); }
+    };
+}
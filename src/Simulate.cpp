@@ -0,0 +1,890 @@
+// orel8155@gmail.com
+/**
+ * @file Simulate.cpp
+ * @brief Headless batch simulator for the Coup card game
+ *
+ * Runs many random games from command-line flags and prints only aggregate
+ * results. Links against the game engine alone (no SFML, no console menu),
+ * so it can be used for large analysis jobs.
+ *
+ * Usage:
+ *   Simulate [--games N] [--players N] [--roles r1,r2,...] [--seed S] [--max-turns T] [--threads N] [--chunk N]
+ *            [--bot-seats s1,s2,...] [--bot-playouts N] [--bot-ms MS] [--bot-threads N] [--bot-mode root|tree]
+ *            [--bot-tt-mb MB] [--mcts-bench N] [--dispatch-bench N] [--pack-bench N]
+ *            [--rule name=value] [--sweep name=lo:hi|name=v1,v2,...]
+ *
+ * With bot seats, the playouts/s line is the engine throughput benchmark.
+ * --mcts-bench searches the opening position with 1, 2, 4, ... N threads and
+ * prints the playouts per second per thread, to check how the search scales.
+ * --dispatch-bench plays N random games through the role classes' virtual
+ * functions and again through the rule table, checks that both reach the
+ * same final positions and prints the turns per second of each.
+ * --pack-bench collects every position of N random games, packs and unpacks
+ * them all and prints the states per second of each direction.
+ * --rule changes one rule value of every game. --sweep gives a rule several
+ * values; with one or more sweeps the batch is played once for every point
+ * of the grid (each point in parallel over all worker threads, with the same
+ * game seeds) and one result row is printed per point, tagged with its values.
+ */
+
+#include "Game.hpp"               // Core game logic
+#include "GameSimulator.hpp"      // Random-policy game simulator
+#include "SimulationRunner.hpp"   // Parallel batch runner
+#include "GameExceptions.hpp"     // Custom exceptions
+#include "PackedState.hpp"        // Packed positions
+#include "Rng.hpp"                // Random streams of the benchmark games
+#include <iostream>               // Input/output streams
+#include <iomanip>                // Output formatting
+#include <sstream>                // Parsing the role list
+#include <string>                 // For string class
+#include <vector>                 // Dynamic arrays
+#include <random>                 // random_device for the default seed
+#include <chrono>                 // Time measurement
+#include <algorithm>              // transform
+#include <cctype>                 // tolower, isdigit
+#include <cstring>                // memcmp
+#include <cstdint>                // INT8_MAX, UINT64_MAX
+using namespace coup;             // Use the coup namespace
+using namespace std;              // Use the standard namespace
+
+namespace
+{
+    /**
+     * Prints the command-line usage
+     * @param program Name of the executable
+     */
+    void printUsage(const char *program)
+    {
+        cout << "Usage: " << program << " [options]\n"
+             << "  --games N        number of games to simulate (default 1000)\n"
+             << "  --players N      number of players, " << DefaultRules::MIN_PLAYERS << "-" << DefaultRules::MAX_PLAYERS
+             << " (default 6, one of each role)\n"
+             << "  --roles LIST     comma separated roles, e.g. general,spy,spy (overrides --players)\n"
+             << "  --seed S         master random seed; game i plays stream i of it (default: random)\n"
+             << "  --max-turns T    turn limit per game (default 300)\n"
+             << "  --threads N      worker threads (default: all cores)\n"
+             << "  --chunk N        games per scheduled chunk (default: automatic)\n"
+             << "  --bot-seats LIST comma separated seats (0-based) played by the MCTS bot\n"
+             << "  --bot-playouts N MCTS playouts per move (default 1000, 0 = time only)\n"
+             << "  --bot-ms MS      MCTS time per move in milliseconds (default 0 = playouts only)\n"
+             << "  --bot-threads N  MCTS search threads per move (default 1)\n"
+             << "  --bot-mode MODE  how MCTS threads share work: root or tree (default tree)\n"
+             << "  --bot-tt-mb MB   share an MCTS transposition table of MB MiB between all bot searches\n"
+             << "  --mcts-bench N   only measure MCTS scaling from 1 to N threads on the opening position\n"
+             << "  --dispatch-bench N only compare virtual and rule-table dispatch over N random games\n"
+             << "  --pack-bench N   only measure packing and unpacking the positions of N random games\n"
+             << "  --rule NAME=V    set a rule value (repeatable), e.g. coup=6\n"
+             << "  --sweep NAME=LO:HI or NAME=V1,V2,...\n"
+             << "                   play the batch for each value (repeatable, the grid of all sweeps)\n"
+             << "                   rules: coup, bribe, sanction, must-coup, invest-cost, invest-return,\n"
+             << "                   coup-block, governor-tax, judge-penalty, baron-refund, merchant-fee,\n"
+             << "                   merchant-income\n"
+             << "  --help           show this message" << endl;
+    }
+
+    /**
+     * A rule value that can be set from the command line
+     */
+    struct RuleParameter
+    {
+        const char *name;                     // Command-line name
+        int (*get)(const RuleConfig &rules);  // Reads the value
+        void (*set)(RuleConfig &rules, int value); // Writes the value
+    };
+
+    /**
+     * The rule values of RuleConfig, by command-line name
+     */
+    const RuleParameter RULE_PARAMETERS[] = {
+        {"coup", [](const RuleConfig &r) -> int { return r.coupCost; },
+         [](RuleConfig &r, int v) { r.coupCost = static_cast<int8_t>(v); }},
+        {"bribe", [](const RuleConfig &r) -> int { return r.bribeCost; },
+         [](RuleConfig &r, int v) { r.bribeCost = static_cast<int8_t>(v); }},
+        {"sanction", [](const RuleConfig &r) -> int { return r.sanctionCost; },
+         [](RuleConfig &r, int v) { r.sanctionCost = static_cast<int8_t>(v); }},
+        {"must-coup", [](const RuleConfig &r) -> int { return r.mustCoupCoins; },
+         [](RuleConfig &r, int v) { r.mustCoupCoins = static_cast<int8_t>(v); }},
+        {"invest-cost", [](const RuleConfig &r) -> int { return r.investCost; },
+         [](RuleConfig &r, int v) { r.investCost = static_cast<int8_t>(v); }},
+        {"invest-return", [](const RuleConfig &r) -> int { return r.investReturn; },
+         [](RuleConfig &r, int v) { r.investReturn = static_cast<int8_t>(v); }},
+        {"coup-block", [](const RuleConfig &r) -> int { return r.coupBlockCost; },
+         [](RuleConfig &r, int v) { r.coupBlockCost = static_cast<int8_t>(v); }},
+        {"governor-tax", [](const RuleConfig &r) -> int { return r.role(Role::GOVERNOR).taxGain; },
+         [](RuleConfig &r, int v) { r.role(Role::GOVERNOR).taxGain = static_cast<int8_t>(v); }},
+        {"judge-penalty", [](const RuleConfig &r) -> int { return r.role(Role::JUDGE).sanctionPenalty; },
+         [](RuleConfig &r, int v) { r.role(Role::JUDGE).sanctionPenalty = static_cast<int8_t>(v); }},
+        {"baron-refund", [](const RuleConfig &r) -> int { return r.role(Role::BARON).sanctionRefund; },
+         [](RuleConfig &r, int v) { r.role(Role::BARON).sanctionRefund = static_cast<int8_t>(v); }},
+        {"merchant-fee", [](const RuleConfig &r) -> int { return r.role(Role::MERCHANT).arrestBankFee; },
+         [](RuleConfig &r, int v) { r.role(Role::MERCHANT).arrestBankFee = static_cast<int8_t>(v); }},
+        {"merchant-income", [](const RuleConfig &r) -> int { return r.role(Role::MERCHANT).incomeAbove; },
+         [](RuleConfig &r, int v) { r.role(Role::MERCHANT).incomeAbove = static_cast<int8_t>(v); }},
+    };
+
+    /**
+     * The values one rule takes in a sweep
+     */
+    struct RuleSweep
+    {
+        const RuleParameter *parameter;  // The swept rule
+        vector<int> values;              // Its values, in order
+    };
+
+    /**
+     * Finds a rule value by its command-line name
+     * @param name The name
+     * @return The rule value
+     * @throws invalid_argument if no rule has the name
+     */
+    const RuleParameter &findRuleParameter(const string &name)
+    {
+        for (const RuleParameter &parameter : RULE_PARAMETERS)
+        {
+            if (name == parameter.name)
+            {
+                return parameter;
+            }
+        }
+        throw invalid_argument("Unknown rule: " + name);
+    }
+
+    constexpr unsigned long long MAX_GAMES = 1000000000;      // Most games of a batch or benchmark
+    constexpr unsigned long long MAX_TURNS = 1000000;         // Highest turn limit of a game
+    constexpr unsigned long long MAX_THREADS = 1024;          // Most threads of a batch or a bot
+    constexpr unsigned long long MAX_PLAYOUTS = 1000000000;   // Highest playout budget of a bot move
+    constexpr unsigned long long MAX_MILLIS = 3600000;        // Highest time budget of a bot move (one hour)
+    constexpr unsigned long long MAX_TABLE_MEGABYTES = 65536; // Largest transposition table
+
+    /**
+     * Parses a non-negative whole number and checks its range
+     * Unlike stoul, rejects a sign (so "-5" does not wrap to a huge count),
+     * leading spaces and anything after the digits
+     * @param text The number
+     * @param low Smallest accepted value
+     * @param high Largest accepted value
+     * @param what Name of the value for the error message
+     * @return The number
+     * @throws invalid_argument if the text is not a number in [low, high]
+     */
+    unsigned long long parseNumber(const string &text, unsigned long long low, unsigned long long high,
+                                   const string &what)
+    {
+        size_t used = 0;
+        unsigned long long value = 0;
+        bool ok = !text.empty() && isdigit(static_cast<unsigned char>(text[0]));
+        try
+        {
+            value = ok ? stoull(text, &used) : 0;
+        }
+        catch (const out_of_range &)
+        {
+            ok = false;
+        }
+        if (!ok || used != text.size() || value < low || value > high)
+        {
+            throw invalid_argument(what + " must be a number from " + to_string(low) + " to " + to_string(high) +
+                                   ": " + text);
+        }
+        return value;
+    }
+
+    /**
+     * Parses one rule value (a small non-negative number)
+     * @param text The value
+     * @return The value
+     * @throws invalid_argument if the value is not in [0, 127]
+     */
+    int parseRuleValue(const string &text)
+    {
+        return static_cast<int>(parseNumber(text, 0, INT8_MAX, "Rule value"));
+    }
+
+    /**
+     * Splits a NAME=VALUE argument
+     * @param text The argument
+     * @param value Output text after the '='
+     * @return The rule named before the '='
+     * @throws invalid_argument if there is no '=' or no rule has the name
+     */
+    const RuleParameter &parseRuleAssignment(const string &text, string &value)
+    {
+        size_t equals = text.find('=');
+        if (equals == string::npos)
+        {
+            throw invalid_argument("Expected NAME=VALUE: " + text);
+        }
+        value = text.substr(equals + 1);
+        return findRuleParameter(text.substr(0, equals));
+    }
+
+    /**
+     * Describes the rule values that differ from the standard rules
+     * @param rules The rule values
+     * @return e.g. "coup=6 judge-penalty=0", or "standard"
+     */
+    string describeRules(const RuleConfig &rules)
+    {
+        const RuleConfig standard;
+        string text;
+        for (const RuleParameter &parameter : RULE_PARAMETERS)
+        {
+            if (parameter.get(rules) != parameter.get(standard))
+            {
+                text += (text.empty() ? "" : " ") + string(parameter.name) + "=" + to_string(parameter.get(rules));
+            }
+        }
+        return text.empty() ? "standard" : text;
+    }
+
+    /**
+     * Parses a role name (case insensitive)
+     * @param text The role name
+     * @return The matching role
+     * @throws invalid_argument if the name is not a role
+     */
+    Role parseRole(string text)
+    {
+        transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return tolower(c); });
+        for (size_t i = 0; i < ROLE_COUNT; ++i)
+        {
+            Role role = static_cast<Role>(i);
+            string name = role_to_string(role);
+            transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return tolower(c); });
+            if (name == text)
+            {
+                return role;
+            }
+        }
+        throw invalid_argument("Unknown role: " + text);
+    }
+
+    /**
+     * Parses the command line into batch options
+     * @param argc Argument count
+     * @param argv Argument values
+     * @param options Output options
+     * @param benchThreads Output thread limit of the MCTS benchmark (0 = no benchmark)
+     * @param tableMegabytes Output size of the bots' transposition table in MiB (0 = no table)
+     * @param dispatchGames Output number of games of the dispatch benchmark (0 = no benchmark)
+     * @param packGames Output number of games of the packing benchmark (0 = no benchmark)
+     * @param sweeps Output swept rules (empty = a single batch)
+     * @return false if the program should exit (help was requested)
+     * @throws invalid_argument on malformed arguments
+     */
+    bool parseArguments(int argc, char *argv[], SimulationConfig &options, unsigned int &benchThreads,
+                        size_t &tableMegabytes, size_t &dispatchGames, size_t &packGames,
+                        vector<RuleSweep> &sweeps)
+    {
+        size_t playerCount = ROLE_COUNT;
+        bool seeded = false;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            string arg = argv[i];
+            if (arg == "--help" || arg == "-h")
+            {
+                printUsage(argv[0]);
+                return false;
+            }
+            if (i + 1 >= argc)
+            {
+                throw invalid_argument("Missing value for " + arg);
+            }
+            string value = argv[++i];
+
+            if (arg == "--games")
+            {
+                options.games = parseNumber(value, 1, MAX_GAMES, arg);
+            }
+            else if (arg == "--players")
+            {
+                playerCount = parseNumber(value, DefaultRules::MIN_PLAYERS, DefaultRules::MAX_PLAYERS, arg);
+            }
+            else if (arg == "--roles")
+            {
+                options.roles.clear();
+                stringstream list(value);
+                string item;
+                while (getline(list, item, ','))
+                {
+                    options.roles.push_back(parseRole(item));
+                }
+            }
+            else if (arg == "--seed")
+            {
+                options.seed = parseNumber(value, 0, UINT64_MAX, arg);
+                seeded = true;
+            }
+            else if (arg == "--max-turns")
+            {
+                options.maxTurns = static_cast<int>(parseNumber(value, 1, MAX_TURNS, arg));
+            }
+            else if (arg == "--threads")
+            {
+                options.threads = static_cast<unsigned int>(parseNumber(value, 0, MAX_THREADS, arg));
+            }
+            else if (arg == "--chunk")
+            {
+                options.chunkSize = parseNumber(value, 0, MAX_GAMES, arg);
+            }
+            else if (arg == "--bot-seats")
+            {
+                options.botSeats = 0;
+                stringstream list(value);
+                string item;
+                while (getline(list, item, ','))
+                {
+                    unsigned long long seat = parseNumber(item, 0, DefaultRules::MAX_PLAYERS - 1, "Bot seat");
+                    options.botSeats |= 1u << seat;
+                }
+            }
+            else if (arg == "--bot-playouts")
+            {
+                options.bot.maxPlayouts = parseNumber(value, 0, MAX_PLAYOUTS, arg);
+            }
+            else if (arg == "--bot-ms")
+            {
+                options.bot.maxMillis = static_cast<int>(parseNumber(value, 0, MAX_MILLIS, arg));
+            }
+            else if (arg == "--bot-threads")
+            {
+                options.bot.threads = static_cast<unsigned int>(parseNumber(value, 1, MAX_THREADS, arg));
+            }
+            else if (arg == "--bot-mode")
+            {
+                if (value == "root")
+                {
+                    options.bot.parallelism = MctsParallelism::ROOT;
+                }
+                else if (value == "tree")
+                {
+                    options.bot.parallelism = MctsParallelism::TREE;
+                }
+                else
+                {
+                    throw invalid_argument("Unknown MCTS mode: " + value);
+                }
+            }
+            else if (arg == "--bot-tt-mb")
+            {
+                tableMegabytes = parseNumber(value, 0, MAX_TABLE_MEGABYTES, arg);
+            }
+            else if (arg == "--mcts-bench")
+            {
+                benchThreads = static_cast<unsigned int>(parseNumber(value, 1, MAX_THREADS, arg));
+            }
+            else if (arg == "--dispatch-bench")
+            {
+                dispatchGames = parseNumber(value, 1, MAX_GAMES, arg);
+            }
+            else if (arg == "--pack-bench")
+            {
+                packGames = parseNumber(value, 1, MAX_GAMES, arg);
+            }
+            else if (arg == "--rule")
+            {
+                string text;
+                const RuleParameter &parameter = parseRuleAssignment(value, text);
+                parameter.set(options.rules, parseRuleValue(text));
+            }
+            else if (arg == "--sweep")
+            {
+                string text;
+                RuleSweep sweep{&parseRuleAssignment(value, text), {}};
+                size_t colon = text.find(':');
+                if (colon != string::npos)
+                {
+                    int low = parseRuleValue(text.substr(0, colon));
+                    int high = parseRuleValue(text.substr(colon + 1));
+                    for (int v = low; v <= high; ++v)
+                    {
+                        sweep.values.push_back(v);
+                    }
+                }
+                else
+                {
+                    stringstream list(text);
+                    string item;
+                    while (getline(list, item, ','))
+                    {
+                        sweep.values.push_back(parseRuleValue(item));
+                    }
+                }
+                if (sweep.values.empty())
+                {
+                    throw invalid_argument("Empty sweep: " + value);
+                }
+                sweeps.push_back(sweep);
+            }
+            else
+            {
+                throw invalid_argument("Unknown option: " + arg);
+            }
+        }
+
+        // Default roster: cycle through the roles in enum order
+        if (options.roles.empty())
+        {
+            for (size_t i = 0; i < playerCount; ++i)
+            {
+                options.roles.push_back(static_cast<Role>(i % ROLE_COUNT));
+            }
+        }
+        if (options.roles.size() < DefaultRules::MIN_PLAYERS || options.roles.size() > DefaultRules::MAX_PLAYERS)
+        {
+            throw invalid_argument("Number of players must be between " + to_string(DefaultRules::MIN_PLAYERS) +
+                                   " and " + to_string(DefaultRules::MAX_PLAYERS));
+        }
+        if (options.botSeats >> options.roles.size())
+        {
+            throw invalid_argument("Bot seat is not in the roster");
+        }
+        if (sweeps.empty() && !options.rules.isValid())
+        {
+            throw invalid_argument("Invalid rule values: " + describeRules(options.rules));
+        }
+        if (!seeded)
+        {
+            options.seed = random_device{}();
+        }
+        return true;
+    }
+
+    /**
+     * Prints the size and hit rate of the bots' transposition table
+     * @param table The table, or nullptr (prints nothing)
+     */
+    void printTable(const TranspositionTable *table)
+    {
+        if (table)
+        {
+            cout << "TT:          " << table->bytes() / (1024.0 * 1024.0) << " MiB, "
+                 << table->hits() << "/" << table->probes() << " hits (" << 100.0 * table->hitRate() << "%)" << endl;
+        }
+    }
+
+    /**
+     * Prints the aggregated results of the batch
+     * @param options The batch options
+     * @param stats The aggregated statistics
+     * @param seconds Wall-clock time of the batch
+     */
+    void printSummary(const SimulationConfig &options, const SimulationStats &stats, double seconds)
+    {
+        auto percent = [&](size_t count) {
+            return stats.games == 0 ? 0.0 : 100.0 * count / stats.games;
+        };
+
+        cout << fixed << setprecision(2);
+        cout << "=== Simulation summary ===" << endl;
+        cout << "Seed:        " << options.seed << endl;
+        cout << "Threads:     " << resolveThreadCount(options.threads) << endl;
+        cout << "Rules:       " << describeRules(options.rules) << endl;
+        cout << "Games:       " << stats.games << endl;
+        cout << "Completed:   " << stats.completed << " (" << percent(stats.completed) << "%)" << endl;
+        cout << "Stalemates:  " << stats.stalemates << " (" << percent(stats.stalemates) << "%)" << endl;
+        cout << "Turn limit:  " << stats.turnLimit << " (" << percent(stats.turnLimit) << "%)" << endl;
+        cout << "Avg turns:   " << (stats.games == 0 ? 0.0 : static_cast<double>(stats.totalTurns) / stats.games) << endl;
+
+        cout << "Wins by role:" << endl;
+        for (size_t i = 0; i < ROLE_COUNT; ++i)
+        {
+            Role role = static_cast<Role>(i);
+            size_t seats = count(options.roles.begin(), options.roles.end(), role);
+            if (seats == 0)
+            {
+                continue;
+            }
+            cout << "  " << left << setw(10) << role_to_string(role) << right
+                 << setw(10) << stats.winsByRole[i] << " (" << percent(stats.winsByRole[i]) << "%, "
+                 << seats << " seat" << (seats > 1 ? "s" : "") << ")" << endl;
+        }
+
+        if (options.botSeats != 0)
+        {
+            cout << "Bot seats:  ";
+            for (size_t seat = 0; seat < options.roles.size(); ++seat)
+            {
+                if ((options.botSeats >> seat) & 1u)
+                {
+                    cout << " " << seat << " (" << role_to_string(options.roles[seat]) << ")";
+                }
+            }
+            cout << endl;
+            cout << "Bot wins:    " << stats.botWins << " (" << percent(stats.botWins) << "%)" << endl;
+            cout << "Playouts:    " << stats.botPlayouts << " ("
+                 << (seconds > 0 ? stats.botPlayouts / seconds : 0.0) << " playouts/s)" << endl;
+            printTable(options.bot.table);
+        }
+
+        cout << "Elapsed:     " << seconds << " s (" << (seconds > 0 ? stats.games / seconds : 0.0) << " games/s)" << endl;
+    }
+
+    /**
+     * Plays the batch once for every point of the grid of the sweeps and prints one row per point
+     * Every point plays the same game seeds, so rows differ only by their rules
+     * @param options The batch options (the swept rules start from options.rules)
+     * @param sweeps The swept rules
+     */
+    void runRuleSweep(const SimulationConfig &options, const vector<RuleSweep> &sweeps)
+    {
+        size_t points = 1;
+        for (const RuleSweep &sweep : sweeps)
+        {
+            points *= sweep.values.size();
+        }
+
+        cout << fixed << setprecision(2);
+        cout << "=== Rule sweep (" << points << " points x " << options.games << " games, seed " << options.seed
+             << ", base rules: " << describeRules(options.rules) << ") ===" << endl;
+        for (const RuleSweep &sweep : sweeps)
+        {
+            cout << setw(max<size_t>(strlen(sweep.parameter->name) + 2, 6)) << sweep.parameter->name;
+        }
+        cout << setw(11) << "Completed" << setw(11) << "Avg turns";
+        for (size_t i = 0; i < ROLE_COUNT; ++i)
+        {
+            Role role = static_cast<Role>(i);
+            if (count(options.roles.begin(), options.roles.end(), role) > 0)
+            {
+                cout << setw(10) << role_to_string(role);
+            }
+        }
+        if (options.botSeats != 0)
+        {
+            cout << setw(10) << "Bot";
+        }
+        cout << endl;
+
+        // Odometer over the values of every sweep, the last sweep changing fastest
+        vector<size_t> index(sweeps.size(), 0);
+        auto start = chrono::steady_clock::now();
+        for (size_t point = 0; point < points; ++point)
+        {
+            SimulationConfig config = options;
+            for (size_t i = 0; i < sweeps.size(); ++i)
+            {
+                sweeps[i].parameter->set(config.rules, sweeps[i].values[index[i]]);
+                cout << setw(max<size_t>(strlen(sweeps[i].parameter->name) + 2, 6)) << sweeps[i].values[index[i]];
+            }
+
+            if (!config.rules.isValid())
+            {
+                cout << "   invalid rule values, skipped" << endl;
+            }
+            else
+            {
+                if (config.bot.table)
+                {
+                    config.bot.table->clear();  // Positions of other rules do not carry over
+                }
+                SimulationStats stats = runSimulations(config);
+                auto percent = [&stats](size_t count) {
+                    return stats.games == 0 ? 0.0 : 100.0 * count / stats.games;
+                };
+                cout << setw(10) << percent(stats.completed) << "%" << setw(11)
+                     << (stats.games == 0 ? 0.0 : static_cast<double>(stats.totalTurns) / stats.games);
+                for (size_t i = 0; i < ROLE_COUNT; ++i)
+                {
+                    if (count(options.roles.begin(), options.roles.end(), static_cast<Role>(i)) > 0)
+                    {
+                        cout << setw(9) << percent(stats.winsByRole[i]) << "%";
+                    }
+                }
+                if (options.botSeats != 0)
+                {
+                    cout << setw(9) << percent(stats.botWins) << "%";
+                }
+                cout << endl;
+            }
+
+            for (size_t i = sweeps.size(); i-- > 0;)
+            {
+                if (++index[i] < sweeps[i].values.size())
+                {
+                    break;
+                }
+                index[i] = 0;
+            }
+        }
+
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        cout << "Elapsed:     " << elapsed.count() << " s (" << resolveThreadCount(options.threads) << " threads)" << endl;
+    }
+
+    /**
+     * Searches the opening position with 1, 2, 4, ... threads and prints the search speed
+     * Near-linear scaling keeps playouts/s per thread close to the single-thread figure
+     * @param options The batch options (roster and bot budget)
+     * @param maxThreads Largest thread count to measure
+     */
+    void runMctsBenchmark(const SimulationConfig &options, unsigned int maxThreads)
+    {
+        Game game;
+        for (size_t seat = 0; seat < options.roles.size(); ++seat)
+        {
+            game.createPlayer(role_to_string(options.roles[seat]) + "_" + to_string(seat + 1), options.roles[seat]);
+        }
+
+        cout << fixed << setprecision(0);
+        cout << "=== MCTS scaling (" << (options.bot.parallelism == MctsParallelism::ROOT ? "root" : "tree")
+             << " parallel) ===" << endl;
+        cout << setw(8) << "Threads" << setw(12) << "Playouts" << setw(14) << "Playouts/s"
+             << setw(16) << "Per thread" << setw(12) << "Scaling";
+        if (options.bot.table)
+        {
+            cout << setw(10) << "TT hits";
+        }
+        cout << endl;
+
+        double single = 0;
+        for (unsigned int threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            MctsConfig config = options.bot;
+            config.threads = threads;
+            config.seed = options.seed;
+            if (config.table)
+            {
+                config.table->clear();  // Every row starts from an empty table
+            }
+            MctsBot bot(config);
+            bot.chooseAction(game);
+
+            const MctsStats &stats = bot.lastStats();
+            if (threads == 1)
+            {
+                single = stats.playoutsPerSecond();
+            }
+            cout << setw(8) << threads << setw(12) << stats.playouts << setw(14) << stats.playoutsPerSecond()
+                 << setw(16) << stats.playoutsPerSecondPerThread() << setw(11) << setprecision(1)
+                 << (single > 0 ? 100.0 * stats.playoutsPerSecond() / (single * threads) : 0.0) << "%";
+            if (config.table)
+            {
+                cout << setw(9) << 100.0 * stats.tableHitRate() << "%";
+            }
+            cout << setprecision(0) << endl;
+        }
+    }
+
+    /**
+     * Plays random games with uniformly chosen legal actions through one dispatch path
+     * @param options The batch options (roster, seed and turn limit)
+     * @param games Number of games
+     * @param useStatic True for applyStatic and the rule table, false for apply and the role classes
+     * @param turns Output total number of turns played
+     * @return XOR of the final position hashes (equal for both paths if they agree)
+     */
+    uint64_t playDispatchGames(const SimulationConfig &options, size_t games, bool useStatic, size_t &turns)
+    {
+        uint64_t finalHashes = 0;
+        turns = 0;
+        for (size_t index = 0; index < games; ++index)
+        {
+            Game game;
+            for (size_t seat = 0; seat < options.roles.size(); ++seat)
+            {
+                game.createPlayer(role_to_string(options.roles[seat]) + "_" + to_string(seat + 1), options.roles[seat]);
+            }
+
+            Rng gen(options.seed, index);
+            for (int turn = 0; turn < options.maxTurns && !game.isGameOver(); ++turn)
+            {
+                LegalActions legal = useStatic ? game.legalActionsStatic() : game.legalActions(*game.getPlayer());
+                if (legal.empty())
+                {
+                    break;
+                }
+                Action action = legal[gen.below(static_cast<uint32_t>(legal.size()))];
+                if (useStatic)
+                {
+                    game.applyStatic(action);
+                }
+                else
+                {
+                    game.apply(action);
+                }
+                game.clearJournal();
+                ++turns;
+            }
+            finalHashes ^= game.hash() * (index + 1);
+        }
+        return finalHashes;
+    }
+
+    /**
+     * Plays the same random games through virtual dispatch and through the rule table
+     * and prints the speed of each
+     * @param options The batch options (roster, seed and turn limit)
+     * @param games Number of games per path
+     * @throws GameException if the two paths reach different positions
+     */
+    void runDispatchBenchmark(const SimulationConfig &options, size_t games)
+    {
+        cout << fixed << setprecision(0);
+        cout << "=== Role dispatch (" << games << " random games) ===" << endl;
+        cout << left << setw(10) << "Path" << right << setw(12) << "Turns" << setw(14) << "Turns/s" << endl;
+
+        uint64_t hashes[2] = {0, 0};
+        double rates[2] = {0, 0};
+        for (int path = 0; path < 2; ++path)
+        {
+            size_t turns = 0;
+            auto start = chrono::steady_clock::now();
+            hashes[path] = playDispatchGames(options, games, path == 1, turns);
+            chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+            rates[path] = elapsed.count() > 0 ? turns / elapsed.count() : 0.0;
+            cout << left << setw(10) << (path == 0 ? "virtual" : "static") << right << setw(12) << turns
+                 << setw(14) << rates[path] << endl;
+        }
+
+        if (hashes[0] != hashes[1])
+        {
+            throw GameException("Dispatch paths reached different positions");
+        }
+        cout << setprecision(2) << "Speedup:    " << (rates[0] > 0 ? rates[1] / rates[0] : 0.0)
+             << "x (same final positions)" << endl;
+    }
+
+    /**
+     * Packs and unpacks every position of random games and prints the speed of each direction
+     * @param options The batch options (roster, seed and turn limit)
+     * @param games Number of games to collect positions from
+     * @throws GameException if a position does not survive the round trip
+     */
+    void runPackBenchmark(const SimulationConfig &options, size_t games)
+    {
+        array<Role, GameState::MAX_PLAYERS> roles{};
+        copy(options.roles.begin(), options.roles.end(), roles.begin());
+
+        // Collect the positions first so that only packing is timed
+        vector<GameState> states;
+        for (size_t index = 0; index < games; ++index)
+        {
+            Game game;
+            for (size_t seat = 0; seat < options.roles.size(); ++seat)
+            {
+                game.createPlayer(role_to_string(options.roles[seat]) + "_" + to_string(seat + 1), options.roles[seat]);
+            }
+
+            Rng gen(options.seed, index);
+            for (int turn = 0; turn < options.maxTurns && !game.isGameOver(); ++turn)
+            {
+                states.push_back(game.snapshot());
+                LegalActions legal = game.legalActionsStatic();
+                if (legal.empty())
+                {
+                    break;
+                }
+                game.applyStatic(legal[gen.below(static_cast<uint32_t>(legal.size()))]);
+                game.clearJournal();
+            }
+        }
+
+        vector<PackedState> packed(states.size());
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < states.size(); ++i)
+        {
+            packState(states[i], roles, packed[i]);
+        }
+        chrono::duration<double> packTime = chrono::steady_clock::now() - start;
+
+        vector<GameState> unpacked(states.size());
+        vector<array<Role, GameState::MAX_PLAYERS>> unpackedRoles(states.size());
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < packed.size(); ++i)
+        {
+            unpackState(packed[i], unpacked[i], unpackedRoles[i]);
+        }
+        chrono::duration<double> unpackTime = chrono::steady_clock::now() - start;
+
+        for (size_t i = 0; i < states.size(); ++i)
+        {
+            if (!canPack(states[i]) || memcmp(&states[i], &unpacked[i], sizeof(GameState)) != 0)
+            {
+                throw GameException("Packed position " + to_string(i) + " did not unpack to the original");
+            }
+        }
+
+        cout << fixed << setprecision(0);
+        cout << "=== Packed positions (" << states.size() << " positions of " << games << " random games) ===" << endl;
+        cout << left << setw(10) << "Step" << right << setw(16) << "States/s" << endl;
+        cout << left << setw(10) << "pack" << right << setw(16)
+             << (packTime.count() > 0 ? states.size() / packTime.count() : 0.0) << endl;
+        cout << left << setw(10) << "unpack" << right << setw(16)
+             << (unpackTime.count() > 0 ? states.size() / unpackTime.count() : 0.0) << endl;
+        cout << "Size:       " << sizeof(PackedState) << " bytes (GameState: " << sizeof(GameState)
+             << " bytes, all positions round-trip)" << endl;
+    }
+}
+
+/**
+ * Entry point of the batch simulator
+ * @return 0 on success, 1 on invalid arguments or errors
+ */
+int main(int argc, char *argv[])
+{
+    SimulationConfig options;
+    unsigned int benchThreads = 0;
+    size_t tableMegabytes = 0;
+    size_t dispatchGames = 0;
+    size_t packGames = 0;
+    vector<RuleSweep> sweeps;
+    try
+    {
+        if (!parseArguments(argc, argv, options, benchThreads, tableMegabytes, dispatchGames, packGames, sweeps))
+        {
+            return 0;
+        }
+    }
+    catch (const exception &e)
+    {
+        cerr << "Error: " << e.what() << endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try
+    {
+        // One table for all bot searches: every game of the batch has the same roster
+        unique_ptr<TranspositionTable> table;
+        if (tableMegabytes > 0)
+        {
+            table = make_unique<TranspositionTable>(tableMegabytes);
+            options.bot.table = table.get();
+        }
+
+        if (benchThreads > 0)
+        {
+            runMctsBenchmark(options, benchThreads);
+            return 0;
+        }
+        if (dispatchGames > 0)
+        {
+            runDispatchBenchmark(options, dispatchGames);
+            return 0;
+        }
+        if (packGames > 0)
+        {
+            runPackBenchmark(options, packGames);
+            return 0;
+        }
+        if (!sweeps.empty())
+        {
+            runRuleSweep(options, sweeps);
+            return 0;
+        }
+
+        auto start = chrono::steady_clock::now();
+        SimulationStats stats = runSimulations(options);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        printSummary(options, stats, elapsed.count());
+    }
+    catch (const exception &e)
+    {
+        cerr << "General error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+//orel8155@gmail.com
+/**
+ * @file SimulationRunner.cpp
+ * @brief Implementation of the parallel simulation runner
+ */
+
+#include "SimulationRunner.hpp"  // Runner declarations
+#include "Game.hpp"              // Core game logic
+#include "GameExceptions.hpp"    // Custom exceptions
+#include "WorkStealingScheduler.hpp" // Chunked work-stealing execution
+#include <thread>                // hardware_concurrency
+
+namespace coup
+{
+    namespace
+    {
+        /**
+         * Per-worker statistics and reused game, padded to its own cache line so
+         * that workers never write to a line shared with another worker
+         */
+        struct alignas(64) WorkerSlot
+        {
+            SimulationStats stats;                  // Results of the games played by this worker
+            unique_ptr<SimulationContext> context;  // Game reused by this worker, built on its first chunk
+        };
+    }
+
+    /**
+     * Constructor - creates the players and the simulator
+     * @param roles Role of each seat
+     * @param maxTurns Turn limit of each game
+     * @param botSeats Bit i set means seat i is played by the MCTS bot
+     * @param bot Budget of the MCTS bot
+     * @param rules Rule values of the games
+     */
+    SimulationContext::SimulationContext(const vector<Role> &roles, int maxTurns, unsigned int botSeats,
+                                         const MctsConfig &bot, const RuleConfig &rules)
+        : game_(rules), bot_(bot), simulator_(game_, game_.getPlayers(), false, 0)
+    {
+        for (Role role : roles)
+        {
+            game_.createPlayer(role_to_string(role), role);
+        }
+        simulator_.setMaxTurns(maxTurns);
+        if (botSeats != 0)
+        {
+            simulator_.setBot(&bot_, botSeats);
+        }
+    }
+
+    /**
+     * Plays one game on the reset game
+     * @param seed Master seed of the game's random streams
+     * @param gameIndex Index of the game, which selects the streams of the seed
+     * @return The result of the game
+     */
+    SimulationResult SimulationContext::play(uint64_t seed, uint64_t gameIndex)
+    {
+        game_.reset();
+        simulator_.reset(seed, gameIndex);
+
+        // The bot is seeded from the game's stream 2^192 numbers ahead, past anything the simulator draws
+        Rng botStream(seed, gameIndex);
+        botStream.longJump();
+        bot_.reseed(botStream());
+        return simulator_.runRandomGame();
+    }
+
+    /**
+     * Plays a single game with the given roster
+     * @param roles Role of each seat
+     * @param seed Master seed of the game's random streams
+     * @param maxTurns Turn limit of the game
+     * @param botSeats Bit i set means seat i is played by the MCTS bot
+     * @param bot Budget of the MCTS bot
+     * @param rules Rule values of the game
+     * @param gameIndex Index of the game, which selects the streams of the seed
+     * @return The result of the game
+     */
+    SimulationResult playSimulatedGame(const vector<Role> &roles, uint64_t seed, int maxTurns,
+                                       unsigned int botSeats, const MctsConfig &bot, const RuleConfig &rules,
+                                       uint64_t gameIndex)
+    {
+        SimulationContext context(roles, maxTurns, botSeats, bot, rules);
+        return context.play(seed, gameIndex);
+    }
+
+    /**
+     * Resolves the number of worker threads to use for a batch
+     * @param requested Requested thread count (0 = hardware concurrency)
+     * @return The number of threads (at least 1)
+     */
+    unsigned int resolveThreadCount(unsigned int requested)
+    {
+        if (requested == 0)
+        {
+            requested = thread::hardware_concurrency();
+        }
+        return requested == 0 ? 1 : requested;
+    }
+
+    /**
+     * Runs a batch of games on several threads and merges the results
+     * Games are handed out in chunks by a work-stealing scheduler, so workers
+     * that draw short games take over chunks from workers that draw long ones
+     * @param config The batch settings
+     * @return Statistics over all games in the batch
+     * @throws GameException if the roster or the rule values are invalid
+     */
+    SimulationStats runSimulations(const SimulationConfig &config)
+    {
+        if (config.roles.size() < DefaultRules::MIN_PLAYERS || config.roles.size() > DefaultRules::MAX_PLAYERS)
+        {
+            throw GameException("Number of players must be between " + to_string(DefaultRules::MIN_PLAYERS) +
+                                " and " + to_string(DefaultRules::MAX_PLAYERS));
+        }
+        if (!config.rules.isValid())
+        {
+            throw GameException("Invalid rule values");
+        }
+
+        WorkStealingScheduler scheduler(resolveThreadCount(config.threads));
+        vector<WorkerSlot> slots(scheduler.threadCount());
+
+        scheduler.parallelFor(config.games, config.chunkSize, [&config, &slots](size_t first, size_t last, unsigned int worker) {
+            WorkerSlot &slot = slots[worker];
+            if (!slot.context)
+            {
+                slot.context = make_unique<SimulationContext>(config.roles, config.maxTurns, config.botSeats, config.bot,
+                                                               config.rules);
+            }
+            for (size_t i = first; i < last; ++i)
+            {
+                slot.stats.record(slot.context->play(config.seed, i));
+            }
+        });
+
+        SimulationStats total;
+        for (const auto &slot : slots)
+        {
+            total.merge(slot.stats);
+        }
+        return total;
+    }
+}
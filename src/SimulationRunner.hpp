@@ -0,0 +1,119 @@
+//orel8155@gmail.com
+/**
+ * @file SimulationRunner.hpp
+ * @brief Parallel batch execution of simulated games
+ *
+ * Spreads independent games across worker threads with a work-stealing
+ * scheduler. Every game gets its own random stream, derived from the batch
+ * seed and the game's index, so a game plays the same whichever thread or
+ * how many threads play the batch. Each
+ * worker accumulates results in its own statistics slot; the slots are
+ * merged once all workers have finished, so no lock is taken while games are
+ * running. A worker builds one Game with its players, simulator and bot and
+ * resets them in place for each game it plays, so after its first game a
+ * worker plays without heap allocations.
+ */
+#pragma once  // Ensures this header file is included only once during compilation
+
+#include "GameSimulator.hpp"  // SimulationResult / SimulationStats
+#include "Game.hpp"           // The reused game
+#include "MctsBot.hpp"        // The reused bot
+#include <vector>             // For vector container
+using namespace std;          // Using standard namespace
+
+namespace coup
+{
+    /**
+     * Settings of a simulation batch
+     */
+    struct SimulationConfig
+    {
+        vector<Role> roles;         // Role of each seat (2-6 seats)
+        size_t games = 1000;        // Number of games to play
+        uint64_t seed = 0;          // Master seed, game i plays stream i of it
+        int maxTurns = 300;         // Turn limit per game
+        unsigned int threads = 0;   // Worker threads (0 = hardware concurrency)
+        size_t chunkSize = 0;       // Games per scheduled chunk (0 = automatic)
+        unsigned int botSeats = 0;  // Bit i set means seat i is played by the MCTS bot
+        MctsConfig bot;             // Budget of the MCTS bot (its seed is derived from the game seed)
+        RuleConfig rules;           // Rule values of every game
+    };
+
+    /**
+     * SimulationContext class - the objects one thread reuses to play games with a roster
+     * The game, its players, the simulator and the bot are built once; play()
+     * resets them to a new seed instead of building them again, so games after
+     * the first do not allocate (unless the bot plays with several threads).
+     * Results are the same as with playSimulatedGame for the same seed
+     */
+    class SimulationContext
+    {
+    public:
+        /**
+         * Constructor - creates the players and the simulator
+         * @param roles Role of each seat
+         * @param maxTurns Turn limit of each game
+         * @param botSeats Bit i set means seat i is played by the MCTS bot
+         * @param bot Budget of the MCTS bot
+         * @param rules Rule values of the games
+         * @throws GameException if the roster or the rule values are invalid
+         */
+        SimulationContext(const vector<Role> &roles, int maxTurns, unsigned int botSeats = 0,
+                          const MctsConfig &bot = MctsConfig(), const RuleConfig &rules = RuleConfig());
+
+        // The simulator and the players refer to the game, so the context stays in place
+        SimulationContext(const SimulationContext &) = delete;
+        SimulationContext &operator=(const SimulationContext &) = delete;
+
+        /**
+         * Plays one game on the reset game
+         * @param seed Master seed of the game's random streams
+         * @param gameIndex Index of the game, which selects the streams of the seed
+         * @return The result of the game
+         */
+        SimulationResult play(uint64_t seed, uint64_t gameIndex = 0);
+
+        /**
+         * Gets the reused game
+         * @return The game (in its final state after play())
+         */
+        const Game &game() const { return game_; }
+
+    private:
+        Game game_;               // The game, reset before every game
+        MctsBot bot_;             // The bot, reseeded before every game
+        GameSimulator simulator_; // Plays the game's turns
+    };
+
+    /**
+     * Plays a single game with the given roster
+     * @param roles Role of each seat
+     * @param seed Master seed of the game's random streams
+     * @param maxTurns Turn limit of the game
+     * @param botSeats Bit i set means seat i is played by the MCTS bot (default: none)
+     * @param bot Budget of the MCTS bot
+     * @param rules Rule values of the game
+     * @param gameIndex Index of the game, which selects the streams of the seed
+     * @return The result of the game (the same as game gameIndex of a batch with this seed)
+     */
+    SimulationResult playSimulatedGame(const vector<Role> &roles, uint64_t seed, int maxTurns,
+                                       unsigned int botSeats = 0, const MctsConfig &bot = MctsConfig(),
+                                       const RuleConfig &rules = RuleConfig(), uint64_t gameIndex = 0);
+
+    /**
+     * Runs a batch of games on several threads and merges the results
+     * The merged statistics depend only on the configuration, not on the
+     * number of threads, because every game is seeded from (seed, index)
+     * @param config The batch settings
+     * @return Statistics over all games in the batch
+     * @throws GameException if the roster or the rule values are invalid
+     */
+    SimulationStats runSimulations(const SimulationConfig &config);
+
+    /**
+     * Resolves the number of worker threads to use for a batch
+     * @param requested Requested thread count (0 = hardware concurrency)
+     * @return The number of threads (at least 1)
+     */
+    unsigned int resolveThreadCount(unsigned int requested);
+}
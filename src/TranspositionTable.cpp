@@ -0,0 +1,202 @@
+//orel8155@gmail.com
+/**
+ * @file TranspositionTable.cpp
+ * @brief Implementation of the lock-free transposition table
+ */
+
+#include "TranspositionTable.hpp"  // Table declarations
+#include <algorithm>               // For min and max
+#include <cmath>                   // For lround
+
+namespace coup
+{
+    namespace
+    {
+        // Layout of a data word: visits in bits 0-31, value in 32-47, depth in 48-55, age in 56-62,
+        // and bit 63 set so that a stored word is never 0 (0 marks an empty entry)
+        constexpr uint64_t VALUE_SHIFT = 32;
+        constexpr uint64_t DEPTH_SHIFT = 48;
+        constexpr uint64_t AGE_SHIFT = 56;
+        constexpr uint64_t AGE_MASK = 0x7F;
+        constexpr uint64_t USED_BIT = 1ull << 63;
+        constexpr double VALUE_SCALE = 65535.0;
+    }
+
+    /**
+     * Constructor - allocates the table
+     * @param megabytes Table size in MiB
+     */
+    TranspositionTable::TranspositionTable(size_t megabytes) : bucketCount_(0), age_(0)
+    {
+        resize(megabytes);
+    }
+
+    /**
+     * Reallocates the table with a new size and clears it
+     * @param megabytes Table size in MiB
+     */
+    void TranspositionTable::resize(size_t megabytes)
+    {
+        // The largest power of two number of buckets that fits in the size
+        size_t wanted = max<size_t>(megabytes * 1024 * 1024 / sizeof(Bucket), 1);
+        size_t count = 1;
+        while (count * 2 <= wanted)
+        {
+            count *= 2;
+        }
+
+        buckets_.reset(new Bucket[count]);
+        bucketCount_ = count;
+        clear();
+    }
+
+    /**
+     * Empties the table and resets the counters
+     */
+    void TranspositionTable::clear()
+    {
+        for (size_t i = 0; i < bucketCount_; ++i)
+        {
+            for (Entry &entry : buckets_[i].entries)
+            {
+                entry.check.store(0, memory_order_relaxed);
+                entry.data.store(0, memory_order_relaxed);
+            }
+        }
+        for (Counter &counter : counters_)
+        {
+            counter.probes.store(0, memory_order_relaxed);
+            counter.hits.store(0, memory_order_relaxed);
+        }
+        age_.store(0, memory_order_relaxed);
+    }
+
+    /**
+     * Packs data and the current age into a data word
+     * @param data The data
+     * @return The data word (never 0)
+     */
+    uint64_t TranspositionTable::pack(const TTData &data) const
+    {
+        double value = min(max(static_cast<double>(data.value), 0.0), 1.0);
+        return static_cast<uint64_t>(data.visits) |
+               (static_cast<uint64_t>(lround(value * VALUE_SCALE)) << VALUE_SHIFT) |
+               (static_cast<uint64_t>(data.depth) << DEPTH_SHIFT) |
+               ((age_.load(memory_order_relaxed) & AGE_MASK) << AGE_SHIFT) | USED_BIT;
+    }
+
+    /**
+     * Unpacks a data word
+     * @param word The data word
+     * @return The data
+     */
+    TTData TranspositionTable::unpack(uint64_t word)
+    {
+        TTData data;
+        data.visits = static_cast<uint32_t>(word);
+        data.value = static_cast<float>(((word >> VALUE_SHIFT) & 0xFFFF) / VALUE_SCALE);
+        data.depth = static_cast<uint8_t>(word >> DEPTH_SHIFT);
+        return data;
+    }
+
+    /**
+     * Looks up a position
+     * @param key The position hash
+     * @param data Receives the stored data on a hit
+     * @return True if the position was found
+     */
+    bool TranspositionTable::probe(uint64_t key, TTData &data) const
+    {
+        Counter &counter = counters_[key >> 60];
+        counter.probes.fetch_add(1, memory_order_relaxed);
+
+        for (const Entry &entry : bucketOf(key).entries)
+        {
+            uint64_t word = entry.data.load(memory_order_relaxed);
+            if (word != 0 && (entry.check.load(memory_order_relaxed) ^ word) == key)
+            {
+                data = unpack(word);
+                counter.hits.fetch_add(1, memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Stores data for a position
+     * The position's own entry is overwritten; otherwise an empty entry is
+     * used, or the one with the least depth after subtracting two levels per
+     * search generation it is old
+     * @param key The position hash
+     * @param data The data to store
+     */
+    void TranspositionTable::store(uint64_t key, const TTData &data)
+    {
+        Bucket &bucket = bucketOf(key);
+        uint64_t age = age_.load(memory_order_relaxed) & AGE_MASK;
+        Entry *victim = &bucket.entries[0];
+        int victimScore = INT32_MAX;
+
+        for (Entry &entry : bucket.entries)
+        {
+            uint64_t word = entry.data.load(memory_order_relaxed);
+            if (word == 0 || (entry.check.load(memory_order_relaxed) ^ word) == key)
+            {
+                victim = &entry;
+                break;
+            }
+
+            int depth = static_cast<int>((word >> DEPTH_SHIFT) & 0xFF);
+            int staleness = static_cast<int>((age - (word >> AGE_SHIFT)) & AGE_MASK);
+            int score = depth - 2 * staleness;
+            if (score < victimScore)
+            {
+                victimScore = score;
+                victim = &entry;
+            }
+        }
+
+        uint64_t word = pack(data);
+        victim->data.store(word, memory_order_relaxed);
+        victim->check.store(key ^ word, memory_order_relaxed);
+    }
+
+    /**
+     * Gets the number of lookups since the last clear
+     * @return Number of probe() calls
+     */
+    uint64_t TranspositionTable::probes() const
+    {
+        uint64_t total = 0;
+        for (const Counter &counter : counters_)
+        {
+            total += counter.probes.load(memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /**
+     * Gets the number of successful lookups since the last clear
+     * @return Number of probe() calls that found their position
+     */
+    uint64_t TranspositionTable::hits() const
+    {
+        uint64_t total = 0;
+        for (const Counter &counter : counters_)
+        {
+            total += counter.hits.load(memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /**
+     * Gets the share of lookups that found their position
+     * @return hits() / probes(), or 0 before the first probe
+     */
+    double TranspositionTable::hitRate() const
+    {
+        uint64_t total = probes();
+        return total == 0 ? 0.0 : static_cast<double>(hits()) / total;
+    }
+}
@@ -0,0 +1,179 @@
+//orel8155@gmail.com
+/**
+ * @file TranspositionTable.hpp
+ * @brief Fixed-size, lock-free table of search results keyed by the position hash
+ *
+ * Many move orders reach the same Coup position (gather and tax commute over
+ * a round), so a search can share what it learned about a position between
+ * all the paths, trees and threads that reach it.
+ *
+ * Each entry is 16 bytes: the 64-bit data word and the key XORed with it.
+ * Threads read and write the two words without locks; a reader accepts an
+ * entry only if the key it recomputes from the two words matches, so an entry
+ * torn by a concurrent write is treated as a miss instead of returning mixed
+ * data. Four entries form a 64-byte bucket (one cache line). A new position
+ * replaces the entry of its bucket with the least work (depth), preferring
+ * entries written by older searches.
+ */
+#pragma once  // Ensures this header file is included only once during compilation
+
+#include <atomic>    // Lock-free entries and counters
+#include <cstddef>   // For size_t
+#include <cstdint>   // For fixed-width integers
+#include <memory>    // For unique_ptr
+using namespace std; // Using standard namespace
+
+namespace coup
+{
+    /**
+     * What the table stores about a position
+     */
+    struct TTData
+    {
+        uint32_t visits = 0;  // Playouts that went through the position
+        float value = 0;      // Mean reward in [0, 1] (kept with 16-bit precision)
+        uint8_t depth = 0;    // Amount of work the entry represents; deeper entries are kept longer
+    };
+
+    /**
+     * TranspositionTable class - lock-free hash table shared by search threads
+     * Keys must come from games with the same roster (the hash does not include roles)
+     */
+    class TranspositionTable
+    {
+    public:
+        /**
+         * Entries per bucket (a bucket fills one 64-byte cache line)
+         */
+        static constexpr size_t BUCKET_SIZE = 4;
+
+        /**
+         * Constructor - allocates the table
+         * @param megabytes Table size in MiB (rounded down to a power of two, at least one bucket)
+         */
+        explicit TranspositionTable(size_t megabytes = 16);
+
+        /**
+         * Reallocates the table with a new size and clears it
+         * Must not be called while a search uses the table
+         * @param megabytes Table size in MiB
+         */
+        void resize(size_t megabytes);
+
+        /**
+         * Empties the table and resets the counters
+         * Must not be called while a search uses the table
+         */
+        void clear();
+
+        /**
+         * Starts a new search generation (older entries become easier to replace)
+         */
+        void newSearch() { age_.fetch_add(1, memory_order_relaxed); }
+
+        /**
+         * Looks up a position
+         * @param key The position hash
+         * @param data Receives the stored data on a hit
+         * @return True if the position was found
+         */
+        bool probe(uint64_t key, TTData &data) const;
+
+        /**
+         * Stores data for a position, replacing its old entry or the least valuable entry of its bucket
+         * @param key The position hash
+         * @param data The data to store
+         */
+        void store(uint64_t key, const TTData &data);
+
+        /**
+         * Gets the table size
+         * @return Size of the entries in bytes
+         */
+        size_t bytes() const { return bucketCount_ * sizeof(Bucket); }
+
+        /**
+         * Gets the number of entries
+         * @return Number of entries
+         */
+        size_t entries() const { return bucketCount_ * BUCKET_SIZE; }
+
+        /**
+         * Gets the number of lookups since the last clear
+         * @return Number of probe() calls
+         */
+        uint64_t probes() const;
+
+        /**
+         * Gets the number of successful lookups since the last clear
+         * @return Number of probe() calls that found their position
+         */
+        uint64_t hits() const;
+
+        /**
+         * Gets the share of lookups that found their position
+         * @return hits() / probes(), or 0 before the first probe
+         */
+        double hitRate() const;
+
+    private:
+        /**
+         * One 16-byte entry: the key is stored XORed with the data word
+         */
+        struct Entry
+        {
+            atomic<uint64_t> check{0};  // key ^ data
+            atomic<uint64_t> data{0};   // Packed TTData and age (0 = empty)
+        };
+
+        /**
+         * Entries that share an index
+         */
+        struct alignas(64) Bucket
+        {
+            Entry entries[BUCKET_SIZE];  // The entries of the bucket
+        };
+        static_assert(sizeof(Entry) == 16, "Entries must pack into 16 bytes");
+        static_assert(sizeof(Bucket) == 64, "A bucket must fill one cache line");
+
+        /**
+         * Probe and hit counters, spread over several cache lines to limit contention
+         */
+        struct alignas(64) Counter
+        {
+            atomic<uint64_t> probes{0};  // Lookups
+            atomic<uint64_t> hits{0};    // Successful lookups
+        };
+
+        /**
+         * Number of counter slots (chosen by key bits)
+         */
+        static constexpr size_t COUNTER_SLOTS = 16;
+
+        unique_ptr<Bucket[]> buckets_;          // The table
+        size_t bucketCount_;                    // Number of buckets (a power of two)
+        atomic<uint8_t> age_;                   // Generation of the current search
+        mutable Counter counters_[COUNTER_SLOTS]; // Probe and hit counters
+
+        /**
+         * Packs data and the current age into a data word
+         * @param data The data
+         * @return The data word (never 0)
+         */
+        uint64_t pack(const TTData &data) const;
+
+        /**
+         * Unpacks a data word
+         * @param word The data word
+         * @return The data
+         */
+        static TTData unpack(uint64_t word);
+
+        /**
+         * Gets the bucket of a key
+         * @param key The position hash
+         * @return The bucket
+         */
+        Bucket &bucketOf(uint64_t key) const { return buckets_[key & (bucketCount_ - 1)]; }
+    };
+}
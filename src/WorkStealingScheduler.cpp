@@ -0,0 +1,199 @@
+//orel8155@gmail.com
+/**
+ * @file WorkStealingScheduler.cpp
+ * @brief Implementation of the work-stealing scheduler
+ */
+
+#include "WorkStealingScheduler.hpp"  // Scheduler declarations
+#include "GameExceptions.hpp"         // Custom exceptions
+#include <algorithm>                  // min / max
+#include <exception>                  // exception_ptr for worker errors
+#include <thread>                     // Worker threads
+
+namespace coup
+{
+    namespace
+    {
+        /**
+         * Packs queue bounds into one word
+         */
+        uint64_t packBounds(uint32_t head, uint32_t tail)
+        {
+            return (static_cast<uint64_t>(head) << 32) | tail;
+        }
+
+        /**
+         * Chunks per worker when the chunk size is chosen automatically;
+         * enough to balance uneven jobs without making chunks tiny
+         */
+        constexpr size_t AUTO_CHUNKS_PER_WORKER = 16;
+    }
+
+    /**
+     * Constructor
+     * @param threads Number of workers (0 = hardware concurrency)
+     */
+    WorkStealingScheduler::WorkStealingScheduler(unsigned int threads)
+        : threads_(threads == 0 ? thread::hardware_concurrency() : threads), steals_(0)
+    {
+        if (threads_ == 0)
+        {
+            threads_ = 1;
+        }
+    }
+
+    /**
+     * Takes the chunk at the head of a queue (owner side)
+     */
+    bool WorkStealingScheduler::popHead(ChunkQueue &queue, uint32_t &chunk)
+    {
+        uint64_t bounds = queue.bounds.load(memory_order_acquire);
+        while (true)
+        {
+            uint32_t head = static_cast<uint32_t>(bounds >> 32);
+            uint32_t tail = static_cast<uint32_t>(bounds);
+            if (head >= tail)
+            {
+                return false;
+            }
+            if (queue.bounds.compare_exchange_weak(bounds, packBounds(head + 1, tail), memory_order_acq_rel))
+            {
+                chunk = head;
+                return true;
+            }
+        }
+    }
+
+    /**
+     * Takes the chunk at the tail of a queue (thief side)
+     */
+    bool WorkStealingScheduler::stealTail(ChunkQueue &queue, uint32_t &chunk)
+    {
+        uint64_t bounds = queue.bounds.load(memory_order_acquire);
+        while (true)
+        {
+            uint32_t head = static_cast<uint32_t>(bounds >> 32);
+            uint32_t tail = static_cast<uint32_t>(bounds);
+            if (head >= tail)
+            {
+                return false;
+            }
+            if (queue.bounds.compare_exchange_weak(bounds, packBounds(head, tail - 1), memory_order_acq_rel))
+            {
+                chunk = tail - 1;
+                return true;
+            }
+        }
+    }
+
+    /**
+     * Runs jobs [0, count) in chunks and returns when all of them are done
+     * @param count Number of jobs
+     * @param chunkSize Jobs per chunk (0 = chosen automatically)
+     * @param task The job body
+     */
+    void WorkStealingScheduler::parallelFor(size_t count, size_t chunkSize, const RangeTask &task)
+    {
+        steals_ = 0;
+        if (count == 0)
+        {
+            return;
+        }
+        if (chunkSize == 0)
+        {
+            chunkSize = max<size_t>(1, count / (static_cast<size_t>(threads_) * AUTO_CHUNKS_PER_WORKER));
+        }
+
+        // Rounded-up division that cannot wrap around for huge counts or chunk sizes
+        size_t chunkCount = count / chunkSize + (count % chunkSize != 0 ? 1 : 0);
+        if (chunkCount > UINT32_MAX)
+        {
+            throw GameException("Too many chunks, use a larger chunk size");
+        }
+        unsigned int workers = static_cast<unsigned int>(min<size_t>(threads_, chunkCount));
+        if (workers == 0)
+        {
+            return;
+        }
+
+        // Deal the chunks out as contiguous shares, one share per worker
+        vector<ChunkQueue> queues(workers);
+        for (unsigned int w = 0; w < workers; ++w)
+        {
+            uint32_t head = static_cast<uint32_t>(chunkCount * w / workers);
+            uint32_t tail = static_cast<uint32_t>(chunkCount * (w + 1) / workers);
+            queues[w].bounds.store(packBounds(head, tail), memory_order_relaxed);
+        }
+
+        vector<exception_ptr> errors(workers);
+        atomic<size_t> steals{0};
+        atomic<bool> failed{false};
+
+        auto run = [&](unsigned int worker) {
+            uint32_t chunk = 0;
+            size_t stolen = 0;
+            try
+            {
+                while (!failed.load(memory_order_relaxed))
+                {
+                    bool found = popHead(queues[worker], chunk);
+                    // Own queue is empty: look for work at the tail of the other queues
+                    for (unsigned int offset = 1; !found && offset < workers; ++offset)
+                    {
+                        found = stealTail(queues[(worker + offset) % workers], chunk);
+                        stolen += found ? 1 : 0;
+                    }
+                    // No chunk left anywhere (chunks are never added back), so stop
+                    if (!found)
+                    {
+                        break;
+                    }
+
+                    size_t first = static_cast<size_t>(chunk) * chunkSize;
+                    task(first, first + min(chunkSize, count - first), worker);
+                }
+            }
+            catch (...)
+            {
+                errors[worker] = current_exception();
+                failed.store(true, memory_order_relaxed);
+            }
+            steals.fetch_add(stolen, memory_order_relaxed);
+        };
+
+        vector<thread> helpers;
+        helpers.reserve(workers - 1);
+        try
+        {
+            for (unsigned int w = 1; w < workers; ++w)
+            {
+                helpers.emplace_back(run, w);
+            }
+        }
+        catch (...)
+        {
+            // A thread could not be started: stop the ones that were and join them
+            // before rethrowing, since destroying a joinable thread terminates
+            failed.store(true, memory_order_relaxed);
+            for (auto &helper : helpers)
+            {
+                helper.join();
+            }
+            throw;
+        }
+        run(0);
+        for (auto &helper : helpers)
+        {
+            helper.join();
+        }
+
+        steals_ = steals.load();
+        for (const auto &error : errors)
+        {
+            if (error)
+            {
+                rethrow_exception(error);
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+//orel8155@gmail.com
+/**
+ * @file WorkStealingScheduler.hpp
+ * @brief Work-stealing scheduler for batches of independent jobs
+ *
+ * A batch of N jobs (for example N simulated games) is cut into chunks of
+ * consecutive indices. Every worker starts with a contiguous share of the
+ * chunks in its own queue and takes chunks from the head of that queue.
+ * A worker whose queue is empty steals chunks from the tail of the other
+ * workers' queues, so all cores stay busy until the last chunk is done even
+ * when job lengths vary a lot.
+ */
+#pragma once  // Ensures this header file is included only once during compilation
+
+#include <atomic>      // Lock-free queue bounds
+#include <cstddef>     // For size_t
+#include <cstdint>     // For uint64_t
+#include <functional>  // For function
+#include <vector>      // For vector container
+using namespace std;   // Using standard namespace
+
+namespace coup
+{
+    /**
+     * Work-stealing scheduler that runs a range of job indices on several threads
+     */
+    class WorkStealingScheduler
+    {
+    public:
+        /**
+         * Job body, called with a half-open range of job indices [first, last)
+         * and the index of the worker running it (0 .. threadCount()-1)
+         */
+        using RangeTask = function<void(size_t first, size_t last, unsigned int worker)>;
+
+        /**
+         * Constructor
+         * @param threads Number of workers (0 = hardware concurrency)
+         */
+        explicit WorkStealingScheduler(unsigned int threads = 0);
+
+        /**
+         * Runs jobs [0, count) in chunks and returns when all of them are done
+         * The calling thread takes part as worker 0
+         * @param count Number of jobs
+         * @param chunkSize Jobs per chunk (0 = chosen automatically)
+         * @param task The job body
+         * @throws The first exception thrown by a task, after all workers stopped
+         */
+        void parallelFor(size_t count, size_t chunkSize, const RangeTask &task);
+
+        /**
+         * Gets the number of workers
+         * @return The worker count
+         */
+        unsigned int threadCount() const { return threads_; }
+
+        /**
+         * Gets the number of chunks that were stolen during the last parallelFor
+         * @return The steal count
+         */
+        size_t lastStealCount() const { return steals_; }
+
+    private:
+        /**
+         * Queue of one worker: the chunk indices [head, tail) packed into one word
+         * (head in the high 32 bits, tail in the low 32 bits). The owner advances
+         * head and thieves lower tail, both with compare-and-swap, so the queue is
+         * lock-free. Padded to its own cache line.
+         */
+        struct alignas(64) ChunkQueue
+        {
+            atomic<uint64_t> bounds{0};
+        };
+
+        /**
+         * Takes the chunk at the head of a queue (owner side)
+         * @param queue The worker's own queue
+         * @param chunk Output chunk index
+         * @return true if a chunk was taken
+         */
+        static bool popHead(ChunkQueue &queue, uint32_t &chunk);
+
+        /**
+         * Takes the chunk at the tail of a queue (thief side)
+         * @param queue Another worker's queue
+         * @param chunk Output chunk index
+         * @return true if a chunk was stolen
+         */
+        static bool stealTail(ChunkQueue &queue, uint32_t &chunk);
+
+        unsigned int threads_;   // Number of workers
+        size_t steals_;          // Chunks stolen during the last parallelFor
+    };
+}
@@ -0,0 +1,68 @@
+//orel8155@gmail.com
+/**
+ * @file Zobrist.hpp
+ * @brief Keys of the incremental 64-bit position hash (Zobrist hashing)
+ *
+ * The hash of a game is the XOR of one key per (field, seat, value) of its
+ * state. When a field changes, the key of the old value is XORed out and the
+ * key of the new value is XORed in, so every update is O(1) and undoing a
+ * change restores the previous hash exactly.
+ *
+ * Instead of a table of random numbers, each key is the splitmix64 finalizer
+ * of its (field, seat, value) triple. That gives the same well-mixed keys for
+ * values of any size (coin counts are not bounded) without a table to fill.
+ */
+#pragma once  // Ensures this header file is included only once during compilation
+
+#include <cstdint>  // For fixed-width integers
+
+namespace coup
+{
+    /**
+     * @enum ZobristField
+     * @brief The parts of the game state that contribute to the hash
+     */
+    enum class ZobristField : uint8_t
+    {
+        COINS,             // Coin count of a seat
+        ACTIVE,            // Seat is still in the game
+        BLOCKED_ECONOMIC,  // Seat is blocked from gather and tax
+        BLOCKED_ARREST,    // Seat is blocked from arresting
+        LAST_ACTION,       // ActionType code of the seat's last action, or NO_ACTION
+        LAST_TARGET,       // Target seat of the seat's last action, or NO_SEAT
+        CURRENT_SEAT,      // Seat whose turn it is
+        PREVIOUS_SEAT,     // Seat that played the previous turn, or NO_SEAT
+        ARRESTED_SEAT,     // Seat of the last arrested player, or NO_SEAT
+        LAST_COUPED_SEAT,  // Seat of the last player eliminated by a coup, or NO_SEAT
+        STARTED            // The first turn has been played
+    };
+
+    /**
+     * @brief Gets the key of one value of one field
+     * @param field The state field
+     * @param seat The seat the field belongs to (0 for game-wide fields)
+     * @param value The value of the field
+     * @return The 64-bit key
+     */
+    constexpr uint64_t zobristKey(ZobristField field, uint8_t seat, int64_t value)
+    {
+        uint64_t x = 0x9E3779B97F4A7C15ull ^ (static_cast<uint64_t>(field) << 56) ^
+                     (static_cast<uint64_t>(seat) << 48) ^ (static_cast<uint64_t>(value) & 0xFFFFFFFFFFFFull);
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * @brief Gets the hash change of a field going from one value to another
+     * @param field The state field
+     * @param seat The seat the field belongs to (0 for game-wide fields)
+     * @param before The old value
+     * @param after The new value
+     * @return The value to XOR into the hash (0 if the value did not change)
+     */
+    constexpr uint64_t zobristDelta(ZobristField field, uint8_t seat, int64_t before, int64_t after)
+    {
+        return before == after ? 0 : zobristKey(field, seat, before) ^ zobristKey(field, seat, after);
+    }
+}
@@ -13,6 +13,10 @@
 #include "../src/Game.hpp"  // Include the Game class
 #include "../src/Player.hpp"  // Include the Player class
 #include "../src/GameExceptions.hpp"  // Include custom exceptions
+#include "../src/Action.hpp"  // Include action descriptions
+#include "../src/GameState.hpp"  // Include the state snapshot
+#include "../src/Roles/General.hpp"  // Include a role to construct directly
+#include <cstring>  // For memcmp
 #include <algorithm>  // For algorithms like std::find
 #include <stdexcept>  // For standard exceptions
 
@@ -302,3 +306,890 @@ TEST_CASE("Game: Complex scenario - multiple eliminations")
     p3->gather();  // P3 performs an action
     CHECK(game.turn() == Role::GOVERNOR);  // Turn should cycle back to P1
 }
+
+/**
+ * Test case that verifies the legal actions listed at the start of a game.
+ * A player with 2 coins can gather, tax and arrest, but cannot bribe or coup.
+ */
+TEST_CASE("Game: Legal actions at game start")
+{
+    Game game;  // Create a new game instance
+    auto p1 = game.createPlayer("P1", Role::GOVERNOR);  // Create first player
+    auto p2 = game.createPlayer("P2", Role::MERCHANT);  // Create second player
+    p1->setCoins(2);  // Give the first player a few coins
+    p2->setCoins(2);  // Give the target a coin to lose
+
+    LegalActions legal = game.legalActions(*p1);  // List the first player's moves
+    CHECK(legal.has(ActionType::GATHER));  // Gather is always possible
+    CHECK(legal.has(ActionType::TAX));  // Tax is possible
+    CHECK_FALSE(legal.has(ActionType::BRIBE));  // Not enough coins to bribe
+    CHECK_FALSE(legal.has(ActionType::INVEST));  // Only the Baron can invest
+    CHECK(legal.contains({ActionType::ARREST, 1}));  // Can arrest the second player
+    CHECK_FALSE(legal.has(ActionType::SANCTION));  // Not enough coins to sanction
+    CHECK_FALSE(legal.has(ActionType::COUP));  // Not enough coins to coup
+
+    CHECK(game.legalActions(*p2).empty());  // Not the second player's turn
+}
+
+/**
+ * Test case that verifies a player with 10 or more coins can only coup.
+ */
+TEST_CASE("Game: Legal actions when a coup is mandatory")
+{
+    Game game;  // Create a new game instance
+    auto p1 = game.createPlayer("P1", Role::GENERAL);  // Create first player
+    auto p2 = game.createPlayer("P2", Role::JUDGE);  // Create second player
+    auto p3 = game.createPlayer("P3", Role::SPY);  // Create third player
+    p1->setCoins(10);  // Force a coup
+
+    LegalActions legal = game.legalActions(*p1);  // List the first player's moves
+    CHECK(legal.size() == 2);  // One coup for each opponent
+    CHECK(legal.contains({ActionType::COUP, 1}));  // Can coup the second player
+    CHECK(legal.contains({ActionType::COUP, 2}));  // Can coup the third player
+}
+
+/**
+ * Test case that verifies a player blocked from economic actions cannot gather or tax.
+ */
+TEST_CASE("Game: Legal actions of a sanctioned player")
+{
+    Game game;  // Create a new game instance
+    auto p1 = game.createPlayer("P1", Role::BARON);  // Create first player
+    auto p2 = game.createPlayer("P2", Role::GOVERNOR);  // Create second player
+    p1->setCoins(3);  // Enough coins to invest or sanction
+    p1->setBlockedFromEconomic(true);  // Sanctioned by another player
+
+    LegalActions legal = game.legalActions(*p1);  // List the first player's moves
+    CHECK_FALSE(legal.has(ActionType::GATHER));  // Gather is blocked
+    CHECK_FALSE(legal.has(ActionType::TAX));  // Tax is blocked
+    CHECK(legal.has(ActionType::INVEST));  // Investing is still allowed
+    CHECK(legal.contains({ActionType::SANCTION, 1}));  // Can sanction the second player
+}
+
+/**
+ * Test case that verifies every listed action can be performed without an exception.
+ */
+TEST_CASE("Game: Every legal action succeeds")
+{
+    vector<Role> roles = {Role::BARON, Role::MERCHANT, Role::GENERAL};
+    for (int coins : {0, 3, 4, 7, 10})
+    {
+        Game probe;  // Game used only to list the moves
+        for (Role role : roles)
+        {
+            probe.createPlayer("P" + to_string(probe.getPlayers().size()), role)->setCoins(coins);
+        }
+
+        for (const Action &action : probe.legalActions(*probe.getPlayers()[0]))
+        {
+            Game game;  // Fresh game for each action
+            for (Role role : roles)
+            {
+                game.createPlayer("P" + to_string(game.getPlayers().size()), role)->setCoins(coins);
+            }
+            auto &players = game.getPlayers();
+            auto &player = players[0];
+
+            switch (action.type)
+            {
+            case ActionType::GATHER:
+                CHECK_NOTHROW(player->gather());
+                break;
+            case ActionType::TAX:
+                CHECK_NOTHROW(player->tax());
+                break;
+            case ActionType::BRIBE:
+                CHECK_NOTHROW(player->bribe());
+                break;
+            case ActionType::INVEST:
+                CHECK_NOTHROW(player->invest());
+                break;
+            case ActionType::ARREST:
+                CHECK_NOTHROW(player->arrest(players[action.target]));
+                break;
+            case ActionType::SANCTION:
+                CHECK_NOTHROW(player->sanction(*players[action.target]));
+                break;
+            case ActionType::COUP:
+                CHECK_NOTHROW(player->coup(players[action.target]));
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * Helper that compares two snapshots byte by byte.
+ */
+static bool sameState(const GameState &a, const GameState &b)
+{
+    return memcmp(&a, &b, sizeof(GameState)) == 0;
+}
+
+/**
+ * Test case that verifies restoring a snapshot brings back coins, flags,
+ * last actions, the arrested and couped players and the turn order.
+ */
+TEST_CASE("Game: Snapshot and restore")
+{
+    Game game;  // Create a new game instance
+    auto general = game.createPlayer("General", Role::GENERAL);  // Create first player
+    auto spy = game.createPlayer("Spy", Role::SPY);  // Create second player
+    auto baron = game.createPlayer("Baron", Role::BARON);  // Create third player
+    general->setCoins(8);  // Enough for a coup
+    spy->setCoins(3);  // Enough for a sanction
+    baron->setCoins(3);  // Enough to be arrested and still invest
+
+    GameState start = game.snapshot();  // State before any action
+    CHECK(start.playerCount == 3);  // Every seat is recorded
+    CHECK(start.currentSeat == 0);  // The General starts
+    CHECK((start.flags & GameState::STARTED) == 0);  // No turn played yet
+
+    general->arrest(baron);  // General arrests the Baron
+    spy->sanction(*baron);  // Spy sanctions the Baron
+    GameState middle = game.snapshot();  // State after two actions
+    CHECK(middle.players[0].lastAction == static_cast<uint8_t>(ActionType::ARREST));  // Last action is recorded
+    CHECK(middle.players[0].lastTarget == 2);  // Target is recorded by seat
+    CHECK(middle.arrestedSeat == 2);  // The Baron is the arrested player
+    CHECK((middle.players[2].flags & PlayerState::BLOCKED_ECONOMIC) != 0);  // The Baron is sanctioned
+
+    baron->invest();  // Baron invests
+    general->coup(spy);  // General eliminates the Spy
+    GameState end = game.snapshot();  // State after the coup
+    CHECK(end.lastCoupedSeat == 1);  // The Spy was couped
+
+    game.restore(middle);  // Go back two actions
+    CHECK(sameState(game.snapshot(), middle));  // Same state as before
+    CHECK(spy->isActive());  // The Spy is back in the game
+    CHECK_FALSE(static_cast<bool>(game.getLastPlayerCouped()));  // No coup yet
+    CHECK(baron->blocked_from_economic());  // The sanction is back
+    CHECK(game.turn() == Role::BARON);  // It is the Baron's turn again
+
+    baron->invest();  // Replay the same actions
+    general->coup(spy);
+    CHECK(sameState(game.snapshot(), end));  // Reaches the same state
+
+    game.restore(start);  // Go back to the beginning
+    CHECK(sameState(game.snapshot(), start));  // Same state as before
+    CHECK(general->get_last_action() == "");  // No action recorded
+    CHECK(game.getArrestedPlayerName() == "");  // Nobody arrested
+    CHECK_FALSE(static_cast<bool>(game.getPreviousPlayer()));  // No previous player
+}
+
+/**
+ * Test case that verifies a snapshot cannot be restored into a game with other seats.
+ */
+TEST_CASE("Game: Restore rejects a snapshot of another roster")
+{
+    Game small;  // Game with two players
+    small.createPlayer("P1", Role::GENERAL);
+    small.createPlayer("P2", Role::SPY);
+
+    Game large;  // Game with three players
+    large.createPlayer("P1", Role::GENERAL);
+    large.createPlayer("P2", Role::SPY);
+    large.createPlayer("P3", Role::JUDGE);
+
+    CHECK_THROWS_AS(large.restore(small.snapshot()), GameException);  // Should throw exception
+}
+
+/**
+ * Test case that verifies apply() refuses illegal actions without recording them.
+ */
+TEST_CASE("Game: Apply refuses illegal actions")
+{
+    Game game;  // Create a new game instance
+    auto p1 = game.createPlayer("P1", Role::GOVERNOR);  // Create first player
+    auto p2 = game.createPlayer("P2", Role::SPY);  // Create second player
+
+    CHECK(game.apply({ActionType::COUP, 1}) == ActionStatus::NOT_ENOUGH_COINS);  // Coup needs 7 coins
+    CHECK(game.apply({ActionType::ARREST, 5}) == ActionStatus::INVALID_TARGET);  // No player in seat 5
+    CHECK(game.journalSize() == 0);  // Nothing was recorded
+    CHECK(game.undoLast() == ActionStatus::NOTHING_TO_UNDO);  // Nothing to undo
+
+    CHECK(game.apply({ActionType::TAX, NO_TARGET}) == ActionStatus::OK);  // Governor collects tax
+    CHECK(p1->coins() == 3);  // Governor's tax is 3 coins
+    CHECK(game.journalSize() == 1);  // The action was recorded
+    CHECK(game.undoLast() == ActionStatus::OK);  // Undo the tax
+    CHECK(p1->coins() == 0);  // Coins are back
+    CHECK(game.turn() == Role::GOVERNOR);  // Turn is back
+}
+
+/**
+ * Test case that verifies undoing a sequence of applied actions passes back
+ * through exactly the same states, in reverse order.
+ */
+TEST_CASE("Game: Apply and undo a random sequence of actions")
+{
+    Game game;  // Create a new game instance
+    game.createPlayer("General", Role::GENERAL);
+    game.createPlayer("Merchant", Role::MERCHANT);
+    game.createPlayer("Judge", Role::JUDGE);
+    game.createPlayer("Baron", Role::BARON);
+    for (auto &player : game.getPlayers())
+    {
+        player->setCoins(5);  // Enough coins for every kind of action
+    }
+
+    vector<GameState> history;  // State before each applied action
+    unsigned int random = 12345;  // Small deterministic generator
+    for (int step = 0; step < 200 && !game.isGameOver(); ++step)
+    {
+        LegalActions legal = game.legalActions(*game.getPlayer());
+        if (legal.empty())
+        {
+            break;
+        }
+        random = random * 1103515245u + 12345u;
+        history.push_back(game.snapshot());
+        CHECK(game.apply(legal[(random >> 16) % legal.size()]) == ActionStatus::OK);  // Listed actions succeed
+    }
+    CHECK(game.journalSize() == history.size());  // Every action was recorded
+
+    bool sameEveryStep = true;
+    while (!history.empty())
+    {
+        game.undoLast();
+        sameEveryStep = sameEveryStep && sameState(game.snapshot(), history.back());
+        history.pop_back();
+    }
+    CHECK(sameEveryStep);  // Each undo restored the state before the action
+    CHECK(game.journalSize() == 0);  // Journal is empty again
+}
+
+/**
+ * Test case that verifies the incremental hash always equals a hash computed from scratch.
+ */
+TEST_CASE("Game: Incremental hash matches the state")
+{
+    Game game;  // Create a new game instance
+    auto general = game.createPlayer("General", Role::GENERAL);
+    game.createPlayer("Spy", Role::SPY);
+    game.createPlayer("Governor", Role::GOVERNOR);
+    CHECK(game.hash() == game.computeHash());  // Creating players updates the hash
+
+    uint64_t start = game.hash();
+    general->setCoins(7);  // Direct changes are hashed too
+    CHECK(game.hash() != start);  // Coins are part of the hash
+    CHECK(game.hash() == game.computeHash());  // Still in step
+    general->setCoins(0);
+    CHECK(game.hash() == start);  // Changing a value back restores the hash
+
+    for (auto &player : game.getPlayers())
+    {
+        player->setCoins(6);  // Enough coins for most actions
+    }
+
+    vector<uint64_t> hashes;  // Hash before each applied action
+    bool matchesEveryStep = true;
+    unsigned int random = 777;  // Small deterministic generator
+    for (int step = 0; step < 150 && !game.isGameOver(); ++step)
+    {
+        LegalActions legal = game.legalActions(*game.getPlayer());
+        if (legal.empty())
+        {
+            break;
+        }
+        random = random * 1103515245u + 12345u;
+        hashes.push_back(game.hash());
+        game.apply(legal[(random >> 16) % legal.size()]);
+        matchesEveryStep = matchesEveryStep && game.hash() == game.computeHash();
+    }
+    CHECK(matchesEveryStep);  // Every action kept the hash in step
+
+    bool restoredEveryStep = true;
+    while (!hashes.empty())
+    {
+        game.undoLast();
+        restoredEveryStep = restoredEveryStep && game.hash() == hashes.back();
+        hashes.pop_back();
+    }
+    CHECK(restoredEveryStep);  // Each undo restored the previous hash
+}
+
+/**
+ * Test case that verifies two move orders reaching the same position have the same hash.
+ */
+TEST_CASE("Game: Transpositions have equal hashes")
+{
+    const Action gather{ActionType::GATHER, NO_TARGET};
+    const Action tax{ActionType::TAX, NO_TARGET};
+    // The General plays tax, gather, gather in one game and gather, tax, gather in the other
+    const Action firstOrder[] = {tax, gather, gather, gather, gather, gather, gather, gather, gather};
+    const Action secondOrder[] = {gather, gather, gather, tax, gather, gather, gather, gather, gather};
+
+    Game first;  // Create two games with the same players
+    Game second;
+    for (Game *game : {&first, &second})
+    {
+        game->createPlayer("General", Role::GENERAL);
+        game->createPlayer("Spy", Role::SPY);
+        game->createPlayer("Judge", Role::JUDGE);
+    }
+
+    bool differedOnTheWay = false;
+    for (size_t turn = 0; turn < 9; ++turn)
+    {
+        CHECK(first.apply(firstOrder[turn]) == ActionStatus::OK);  // Every action is legal
+        CHECK(second.apply(secondOrder[turn]) == ActionStatus::OK);
+        differedOnTheWay = differedOnTheWay || first.hash() != second.hash();
+    }
+
+    CHECK(differedOnTheWay);  // The positions in between differ
+    CHECK(sameState(first.snapshot(), second.snapshot()));  // Both games end in the same position
+    CHECK(first.hash() == second.hash());  // Same position, same hash
+}
+
+/**
+ * Test case that verifies the active count and last survivor follow every way a player leaves or returns.
+ */
+TEST_CASE("Game: Active count follows eliminations and revivals")
+{
+    Game game;  // Create a new game instance
+    auto general = game.createPlayer("General", Role::GENERAL);
+    game.createPlayer("Spy", Role::SPY);
+    game.createPlayer("Judge", Role::JUDGE);
+    CHECK(game.activeCount() == 3);  // Every new player is active
+    CHECK(game.activeSeats() == 0b111);  // Seats 0-2
+    CHECK(game.lastSurvivorSeat() == NO_SEAT);  // Nobody has won
+
+    general->setCoins(7);
+    GameState start = game.snapshot();  // Before the coup
+    CHECK(game.apply({ActionType::COUP, 1}) == ActionStatus::OK);  // General coups the Spy
+    CHECK(game.activeCount() == 2);  // A coup removes a player
+    CHECK(game.activeSeats() == 0b101);  // The Spy's seat is cleared
+
+    game.undoLast();
+    CHECK(game.activeCount() == 3);  // Undoing the coup brings the Spy back
+
+    game.apply({ActionType::COUP, 1});
+    general->setCoins(5);
+    general->undo(UndoableAction::COUP);  // The General pays 5 to revive the Spy
+    CHECK(game.activeCount() == 3);  // Revival counts the Spy again
+    CHECK(game.activeSeats() == 0b111);
+
+    game.removePlayer("Spy");
+    game.removePlayer("Judge");
+    CHECK(game.activeCount() == 1);  // Removing players counts too
+    CHECK(game.isGameOver());  // One player left
+    CHECK(game.lastSurvivorSeat() == 0);  // The General
+    CHECK(game.winnerSeat() == 0);
+    CHECK(game.winner() == "General");
+
+    game.restore(start);
+    CHECK(game.activeCount() == 3);  // Restoring a snapshot recounts
+    CHECK_FALSE(game.isGameOver());
+}
+
+/**
+ * Test case that verifies the active player view walks the active seats in order without copying names.
+ */
+TEST_CASE("Game: Active player view")
+{
+    Game game;  // Create a new game instance
+    game.createPlayer("General", Role::GENERAL);
+    auto spy = game.createPlayer("Spy", Role::SPY);
+    game.createPlayer("Judge", Role::JUDGE);
+    game.createPlayer("Baron", Role::BARON);
+
+    auto view = game.activePlayers();
+    CHECK(view.size() == 4);  // Every new player is in the view
+    vector<string> names;
+    for (const auto &player : view)
+    {
+        names.push_back(player->name());
+    }
+    CHECK(names == game.players());  // Same players and order as the name-based API
+
+    spy->setActive(false);
+    CHECK(game.activePlayers().size() == 3);  // Inactive seats are skipped
+    auto it = game.activePlayers().begin();
+    CHECK(it.seat() == 0);  // General
+    ++it;
+    CHECK(it.seat() == 2);  // Judge, after the Spy's empty seat
+    CHECK((*it)->name() == "Judge");
+
+    size_t visited = 0;
+    for (const auto &player : game.activePlayers())
+    {
+        player->setActive(false);  // Eliminating while iterating is safe
+        ++visited;
+    }
+    CHECK(visited == 3);  // The view walks the seats active when it was taken
+    CHECK(game.activePlayers().empty());
+}
+
+/**
+ * Test case that verifies names map to seats through the index and that the engine tracks players by seat.
+ */
+TEST_CASE("Game: Seats and the name index")
+{
+    Game game;  // Create a new game instance
+    auto first = game.createPlayer("Alice", Role::GENERAL);
+    auto second = game.createPlayer("Alice", Role::GENERAL);  // Same name and role
+    auto bob = game.createPlayer("Bob", Role::SPY);
+
+    CHECK(second->name() == "Alice_2");  // Duplicate names get a counter
+    CHECK(game.seatOfName("Alice") == 0);  // Names map to their seats
+    CHECK(game.seatOfName("Alice_2") == 1);
+    CHECK(game.seatOfName("Bob") == 2);
+    CHECK(game.seatOfName("Charlie") == NO_SEAT);  // Unknown names do not throw
+    CHECK(game.playerName(2) == "Bob");  // And seats map back to names
+
+    // Turn ownership follows the seat, not the role
+    CHECK(game.currentSeat() == 0);
+    CHECK(first->tryGather() == ActionStatus::OK);  // Seat 0 plays
+    CHECK(first->tryGather() == ActionStatus::NOT_YOUR_TURN);  // Now it is seat 1's turn
+    CHECK(second->tryGather() == ActionStatus::OK);  // The second General is a different seat
+
+    // Arrest and coup tracking are kept by seat
+    CHECK(bob->tryArrest(first) == ActionStatus::OK);
+    CHECK(game.arrestedSeat() == 0);
+    CHECK(game.getArrestedPlayerName() == "Alice");
+    first->setCoins(7);
+    CHECK(first->tryCoup(bob) == ActionStatus::OK);
+    CHECK(game.lastCoupedSeat() == 2);
+    CHECK((game.getLastPlayerCouped() == bob));  // Still available as a pointer
+}
+
+/**
+ * Test case that verifies player objects read and write their seat of the game's player table.
+ */
+TEST_CASE("Game: Players are handles onto the player table")
+{
+    Game game;  // Create a new game instance
+    auto general = game.createPlayer("General", Role::GENERAL);
+    auto spy = game.createPlayer("Spy", Role::SPY);
+    auto baron = game.createPlayer("Baron", Role::BARON);
+
+    CHECK(general->role() == Role::GENERAL);  // Roles are read from the table
+    CHECK(spy->role() == Role::SPY);
+    CHECK(baron->coins() == 0);  // New seats start empty
+    CHECK(baron->lastActionCode() == NO_ACTION);
+
+    spy->setCoins(4);
+    spy->setBlockedFromEconomic(true);
+    baron->setActive(false);
+    GameState state = game.snapshot();  // The snapshot reads the table
+    CHECK(state.players[1].coins == 4);
+    CHECK(state.players[1].flags == (PlayerState::ACTIVE | PlayerState::BLOCKED_ECONOMIC));
+    CHECK(state.players[2].flags == 0);  // The Baron is out
+    CHECK(game.activeSeats() == 0b011);
+    CHECK_FALSE(general->blocked_from_economic());  // Neighbouring seats are untouched
+    CHECK(game.hash() == game.computeHash());  // Setters keep the hash in step
+
+    // The table only has room for six seats
+    for (int i = 0; i < 3; ++i)
+    {
+        game.createPlayer("Extra", Role::MERCHANT);
+    }
+    CHECK_THROWS_AS(game.createPlayer("Seventh", Role::JUDGE), GameException);
+    CHECK_THROWS_AS(General(game, "Direct", Role::GENERAL), GameException);  // Even when constructed directly
+}
+
+/**
+ * Test case that verifies the rule-table path gives the same statuses, states and hashes as the virtual path.
+ */
+TEST_CASE("Game: Static dispatch matches the role classes")
+{
+    const Role roles[] = {Role::GENERAL, Role::GOVERNOR, Role::SPY, Role::BARON, Role::JUDGE, Role::MERCHANT};
+    unsigned int random = 2024;  // Small deterministic generator
+    auto next = [&random]() {
+        random = random * 1103515245u + 12345u;
+        return random >> 16;
+    };
+
+    for (int round = 0; round < 60; ++round)
+    {
+        Game virtualGame;  // Played through apply() and the role classes
+        Game staticGame;   // Played through applyStatic() and the rule table
+        size_t count = 2 + next() % 5;
+        for (size_t seat = 0; seat < count; ++seat)
+        {
+            Role role = roles[next() % 6];
+            virtualGame.createPlayer("P" + to_string(seat), role);
+            staticGame.createPlayer("P" + to_string(seat), role);
+        }
+
+        for (int turn = 0; turn < 80 && !virtualGame.isGameOver(); ++turn)
+        {
+            LegalActions legal = virtualGame.legalActions(*virtualGame.getPlayer());
+            LegalActions legalStatic = staticGame.legalActionsStatic();
+            REQUIRE(legal.size() == legalStatic.size());  // Same legal actions in the same order
+            for (size_t i = 0; i < legal.size(); ++i)
+            {
+                CHECK(legal[i] == legalStatic[i]);
+            }
+
+            // Every action against every seat gets the same answer; legal ones are undone again
+            for (size_t type = 0; type < ACTION_TYPE_COUNT; ++type)
+            {
+                for (uint8_t target = 0; target <= count; ++target)
+                {
+                    Action action{static_cast<ActionType>(type), target == count ? NO_TARGET : target};
+                    ActionStatus status = virtualGame.apply(action);
+                    CHECK(staticGame.applyStatic(action) == status);
+                    CHECK(sameState(virtualGame.snapshot(), staticGame.snapshot()));
+                    CHECK(virtualGame.hash() == staticGame.hash());
+                    if (status == ActionStatus::OK)
+                    {
+                        virtualGame.undoLast();
+                        staticGame.undoLast();
+                    }
+                }
+            }
+
+            if (legal.empty())
+            {
+                break;
+            }
+            Action action = legal[next() % legal.size()];
+            virtualGame.apply(action);
+            staticGame.applyStatic(action);
+            CHECK(sameState(virtualGame.snapshot(), staticGame.snapshot()));  // Same position after the move
+            CHECK(virtualGame.hash() == staticGame.hash());
+        }
+    }
+}
+
+/**
+ * Test case that verifies a reset game is in the same state as a new game and keeps or replaces its players.
+ */
+TEST_CASE("Game: Reset restarts the game in place")
+{
+    Game game;  // Create a new game instance
+    auto governor = game.createPlayer("Governor", Role::GOVERNOR);
+    auto spy = game.createPlayer("Spy", Role::SPY);
+    Game fresh;  // A new game with the same roster
+    fresh.createPlayer("Governor", Role::GOVERNOR);
+    fresh.createPlayer("Spy", Role::SPY);
+    CHECK(game.sameRoster(fresh));  // Same names and roles in the same seats
+
+    CHECK(game.apply({ActionType::TAX, NO_TARGET}) == ActionStatus::OK);  // Play a few turns
+    CHECK(game.apply({ActionType::GATHER, NO_TARGET}) == ActionStatus::OK);  // The Spy gathers
+    CHECK(game.apply({ActionType::SANCTION, 1}) == ActionStatus::OK);  // The Governor sanctions with 3 coins
+    spy->setActive(false);
+    CHECK(game.hash() != fresh.hash());  // The game has moved on
+
+    game.reset();
+    CHECK(game.hash() == fresh.hash());  // Back to the state of a new game
+    CHECK(game.hash() == game.computeHash());  // The hash was kept in step
+    GameState after = game.snapshot();
+    GameState expected = fresh.snapshot();
+    CHECK(memcmp(&after, &expected, sizeof(GameState)) == 0);  // Every field matches
+    CHECK(game.journalSize() == 0);  // Nothing left to undo
+    CHECK((game.getPlayers()[0] == governor));  // The same player objects are kept
+    CHECK(spy->isActive());  // Eliminated players are back
+    CHECK(governor->coins() == 0);  // Coins start from zero
+    CHECK(after.bank == Game::INITIAL_BANK);  // The bank is full again
+    CHECK(game.turn() == Role::GOVERNOR);  // The first seat starts again
+
+    // The same roster keeps the players, a new roster replaces them
+    game.reset({Role::GOVERNOR, Role::SPY}, {"Governor", "Spy"});
+    CHECK((game.getPlayers()[1] == spy));  // Unchanged roster
+    game.reset({Role::BARON, Role::JUDGE, Role::MERCHANT}, {"Baron", "Judge", "Merchant"});
+    CHECK(game.players() == vector<string>{"Baron", "Judge", "Merchant"});  // New players in order
+    CHECK(game.getPlayerByName("Judge")->role() == Role::JUDGE);  // The name index follows the roster
+    CHECK(game.seatOfName("Spy") == NO_SEAT);  // Old names are gone
+    CHECK(game.activeSeats() == 0b111);  // All new seats are active
+    CHECK(game.hash() == game.computeHash());  // The hash covers the new seats
+    CHECK_FALSE(game.sameRoster(fresh));  // The rosters now differ
+    CHECK_THROWS_AS(game.reset({Role::SPY}, {}), GameException);  // Every seat needs a name
+}
+
+/**
+ * Test case that verifies player handles resolve to their players, drive actions and go stale when the roster changes.
+ */
+TEST_CASE("Game: Player handles")
+{
+    Game game;  // Create a new game instance
+    auto general = game.createPlayer("General", Role::GENERAL);
+    auto spy = game.createPlayer("Spy", Role::SPY);
+    auto baron = game.createPlayer("Baron", Role::BARON);
+
+    PlayerHandle spyHandle = spy->handle();
+    CHECK(spyHandle.seat == 1);  // A handle is the seat and its generation
+    CHECK(spyHandle == game.handleOf(1));
+    CHECK(game.resolve(spyHandle) == spy.get());  // Resolves without touching the reference count
+    CHECK(&game.player(spyHandle) == spy.get());
+    CHECK_FALSE(game.isValid(PlayerHandle()));  // The empty handle refers to nobody
+    CHECK(game.resolve(game.handleOf(5)) == nullptr);  // Nor does an empty seat
+    CHECK_THROWS_AS(game.player(PlayerHandle()), PlayerNotFound);
+
+    // Actions and bookkeeping through handles
+    general->setCoins(7);
+    CHECK(general->tryCoup(spyHandle) == ActionStatus::OK);
+    CHECK_FALSE(spy->isActive());  // The coup reached the Spy
+    CHECK(game.lastCoupedPlayer() == spyHandle);  // Recorded as a handle
+    CHECK((game.getLastPlayerCouped() == spy));  // The pointer getter agrees
+    CHECK(game.previousPlayer() == general->handle());  // The General played last
+    CHECK(game.currentPlayer() == baron->handle());  // The Spy's turn is skipped
+    CHECK(baron->trySanction(general->handle()) == ActionStatus::NOT_ENOUGH_COINS);  // Rules still apply
+    CHECK_THROWS_AS(baron->coup(general->handle()), NotEnoughCoins);  // Throwing versions too
+
+    // A new roster gives every seat a new generation
+    game.reset({Role::JUDGE, Role::MERCHANT}, {"Judge", "Merchant"});
+    CHECK_FALSE(game.isValid(spyHandle));  // The Spy's handle is stale
+    CHECK(game.resolve(spyHandle) == nullptr);
+    CHECK(game.handleOf(1).generation == spyHandle.generation + 1);  // Same seat, next generation
+    CHECK(game.getPlayers()[0]->tryArrest(spyHandle) == ActionStatus::INVALID_TARGET);  // Refused, nothing changes
+    CHECK(game.getPlayers()[0]->coins() == 0);
+    game.reset();  // Restarting the same roster keeps the players and their handles
+    CHECK(game.isValid(game.handleOf(1)));
+}
+
+/**
+ * Test case that verifies positions pack into 32 canonical bytes and unpack without loss.
+ */
+TEST_CASE("Game: Packed positions")
+{
+    const Role roles[] = {Role::GENERAL, Role::GOVERNOR, Role::SPY, Role::BARON, Role::JUDGE, Role::MERCHANT};
+    unsigned int random = 7;  // Small deterministic generator
+    auto next = [&random]() {
+        random = random * 1103515245u + 12345u;
+        return random >> 16;
+    };
+
+    for (int round = 0; round < 40; ++round)
+    {
+        Game game;  // The game that is played
+        Game copy;  // Same roster, receives the unpacked positions
+        size_t count = 2 + next() % 5;
+        for (size_t seat = 0; seat < count; ++seat)
+        {
+            Role role = roles[next() % 6];
+            game.createPlayer("P" + to_string(seat), role);
+            copy.createPlayer("P" + to_string(seat), role);
+        }
+
+        for (int turn = 0; turn < 120 && !game.isGameOver(); ++turn)
+        {
+            PackedState packed;
+            REQUIRE(game.pack(packed));  // Every reachable position fits
+            GameState state;
+            array<Role, GameState::MAX_PLAYERS> unpackedRoles;
+            unpackState(packed, state, unpackedRoles);
+            GameState expected = game.snapshot();
+            CHECK(memcmp(&state, &expected, sizeof(GameState)) == 0);  // Lossless, byte for byte
+            for (size_t seat = 0; seat < count; ++seat)
+            {
+                CHECK(unpackedRoles[seat] == game.getPlayers()[seat]->role());  // Roles come back too
+            }
+
+            copy.unpack(packed);
+            CHECK(copy.hash() == game.hash());  // The copy reached the same position
+            PackedState again;
+            CHECK(copy.pack(again));
+            CHECK(again == packed);  // Canonical: the same position gives the same bytes
+
+            LegalActions legal = game.legalActionsStatic();
+            if (legal.empty())
+            {
+                break;
+            }
+            game.applyStatic(legal[next() % legal.size()]);
+        }
+    }
+
+    Game game;  // Limits of the encoding
+    auto spy = game.createPlayer("Spy", Role::SPY);
+    game.createPlayer("Judge", Role::JUDGE);
+    PackedState packed;
+    spy->setCoins(PACKED_MAX_COINS);
+    CHECK(game.pack(packed));  // The largest coin count fits
+    spy->setCoins(PACKED_MAX_COINS + 1);
+    CHECK_FALSE(game.pack(packed));  // One more does not
+
+    Game other;  // Same size, different roles
+    other.createPlayer("Spy", Role::SPY);
+    other.createPlayer("Baron", Role::BARON);
+    spy->setCoins(3);
+    REQUIRE(game.pack(packed));
+    CHECK_THROWS_AS(other.unpack(packed), GameException);  // Positions only load into matching rosters
+}
+
+namespace
+{
+    /**
+     * A variant rule set with a cheaper coup and a Governor whose tax brings 4 coins
+     */
+    constexpr RoleRules RICH_GOVERNOR = {4, 0, true, false, true, 0, 0, 0, NO_INCOME};
+
+    struct CheapCoupRules : DefaultRules
+    {
+        static constexpr int COUP_COST = 5;
+
+        static constexpr const RoleRules &role(Role role)
+        {
+            return role == Role::GOVERNOR ? RICH_GOVERNOR : DefaultRules::role(role);
+        }
+    };
+}
+
+/**
+ * Test case that verifies the rule-table path plays a compile-time variant rule set
+ */
+TEST_CASE("Game: Variant rule sets")
+{
+    static_assert(DefaultRules::COUP_COST == 7 && DefaultRules::MUST_COUP_COINS == 10, "Standard rules");
+    static_assert(CheapCoupRules::BRIBE_COST == DefaultRules::BRIBE_COST, "Variants inherit what they keep");
+
+    Game game;
+    auto governor = game.createPlayer("Governor", Role::GOVERNOR);
+    auto spy = game.createPlayer("Spy", Role::SPY);
+    governor->setCoins(5);
+
+    CHECK_FALSE(game.legalActionsStatic().has(ActionType::COUP));  // 5 coins do not pay for a standard coup
+    CHECK(game.legalActionsStatic<CheapCoupRules>().has(ActionType::COUP));  // They pay for the variant's
+    CHECK(game.applyStatic({ActionType::COUP, spy->seat()}) == ActionStatus::NOT_ENOUGH_COINS);  // The standard rules refuse it
+
+    GameState before = game.snapshot();
+    CHECK(game.applyStatic<CheapCoupRules>({ActionType::TAX, NO_TARGET}) == ActionStatus::OK);
+    CHECK(governor->coins() == 9);  // The variant Governor's tax brings 4
+    CHECK(game.snapshot().bank == before.bank);  // And still costs the bank nothing
+    game.undoLast();
+
+    CHECK(game.applyStatic<CheapCoupRules>({ActionType::COUP, spy->seat()}) == ActionStatus::OK);
+    CHECK(governor->coins() == 0);  // The variant coup cost 5
+    CHECK_FALSE(spy->isActive());
+    CHECK(game.isGameOver());
+}
+
+/**
+ * Helper that plays random games under a rule config through apply() and the
+ * role classes and through applyRules() and the rule table, and checks that
+ * both paths list the same legal actions and reach the same positions.
+ */
+static void playBothRulePaths(const RuleConfig &rules)
+{
+    const Role roles[] = {Role::GENERAL, Role::GOVERNOR, Role::SPY, Role::BARON, Role::JUDGE, Role::MERCHANT};
+    unsigned int random = 99;  // Small deterministic generator
+    auto next = [&random]() {
+        random = random * 1103515245u + 12345u;
+        return random >> 16;
+    };
+
+    for (int round = 0; round < 40; ++round)
+    {
+        Game virtualGame(rules);  // Played through apply() and the role classes
+        Game tableGame(rules);    // Played through applyRules() and the rule table
+        size_t count = 2 + next() % 5;
+        for (size_t seat = 0; seat < count; ++seat)
+        {
+            Role role = roles[next() % 6];
+            virtualGame.createPlayer("P" + to_string(seat), role);
+            tableGame.createPlayer("P" + to_string(seat), role);
+        }
+
+        for (int turn = 0; turn < 80 && !virtualGame.isGameOver(); ++turn)
+        {
+            LegalActions legal = virtualGame.legalActions(*virtualGame.getPlayer());
+            LegalActions legalTable = tableGame.legalActionsRules();
+            REQUIRE(legal.size() == legalTable.size());  // Same legal actions under the changed values
+            for (size_t i = 0; i < legal.size(); ++i)
+            {
+                CHECK(legal[i] == legalTable[i]);
+            }
+            if (legal.empty())
+            {
+                break;
+            }
+            Action action = legal[next() % legal.size()];
+            CHECK(virtualGame.apply(action) == ActionStatus::OK);
+            CHECK(tableGame.applyRules(action) == ActionStatus::OK);
+            GameState expected = virtualGame.snapshot();
+            GameState actual = tableGame.snapshot();
+            CHECK(memcmp(&expected, &actual, sizeof(GameState)) == 0);  // Same position after the move
+        }
+    }
+}
+
+/**
+ * Test case that verifies run-time rule values are played the same by the role classes and the rule table
+ */
+TEST_CASE("Game: Run-time rule values")
+{
+    CHECK(sizeof(RuleConfig) == 64);  // One cache line
+    CHECK(RuleConfig().isStandard());  // The defaults are the standard rules
+
+    RuleConfig rules;  // Every value changed
+    rules.coupCost = 5;
+    rules.bribeCost = 3;
+    rules.sanctionCost = 2;
+    rules.mustCoupCoins = 8;
+    rules.investCost = 2;
+    rules.investReturn = 5;
+    rules.coupBlockCost = 4;
+    rules.role(Role::GOVERNOR).taxGain = 4;
+    rules.role(Role::JUDGE).sanctionPenalty = 2;
+    rules.role(Role::BARON).sanctionRefund = 2;
+    rules.role(Role::MERCHANT).arrestBankFee = 1;
+    rules.role(Role::MERCHANT).incomeAbove = 4;
+    REQUIRE(rules.isValid());
+    CHECK_FALSE(rules.isStandard());
+
+    playBothRulePaths(rules);  // The role classes and the rule table agree
+
+    Game game(rules);  // The values reach the actions
+    auto spy = game.createPlayer("Spy", Role::SPY);
+    auto judge = game.createPlayer("Judge", Role::JUDGE);
+    spy->setCoins(5);
+    spy->coup(judge);
+    CHECK(spy->coins() == 0);  // The coup cost 5
+    CHECK_FALSE(judge->isActive());
+
+    Game standard;  // Same roster, standard rules
+    standard.createPlayer("Spy", Role::SPY);
+    standard.createPlayer("Judge", Role::JUDGE);
+    CHECK_FALSE(standard.sameRoster(game));  // Rules are part of the roster check
+
+    RuleConfig broken;
+    broken.mustCoupCoins = 6;  // A forced coup would be unaffordable
+    CHECK_FALSE(broken.isValid());
+    CHECK_THROWS_AS(Game{broken}, GameException);  // Invalid values are rejected at construction
+}
+
+/**
+ * Test case that verifies every field of a role's RoleRules entry reaches the
+ * virtual path, so apply() and applyRules() play the same game when the
+ * switches and role-specific numbers move to other roles.
+ */
+TEST_CASE("Game: Role table values reach the role classes")
+{
+    RuleConfig rules;  // Role abilities moved around
+    rules.role(Role::GENERAL).canInvest = true;
+    rules.role(Role::BARON).canInvest = false;
+    rules.role(Role::SPY).taxChecksBlockFirst = true;
+    rules.role(Role::GOVERNOR).taxChecksBlockFirst = false;
+    rules.role(Role::GOVERNOR).taxBankCost = 1;
+    rules.role(Role::GOVERNOR).arrestTakesCoin = false;
+    rules.role(Role::MERCHANT).arrestTakesCoin = true;
+    rules.role(Role::MERCHANT).arrestBankFee = 0;
+    rules.role(Role::JUDGE).arrestBankFee = 1;
+    rules.role(Role::SPY).incomeAbove = 2;
+    rules.role(Role::GENERAL).sanctionRefund = 1;
+    rules.role(Role::GOVERNOR).sanctionPenalty = 1;
+    REQUIRE(rules.isValid());
+
+    playBothRulePaths(rules);  // The role classes and the rule table agree
+
+    Game game(rules);  // Create a new game instance
+    auto general = game.createPlayer("General", Role::GENERAL);
+    auto baron = game.createPlayer("Baron", Role::BARON);
+    auto spy = game.createPlayer("Spy", Role::SPY);
+    general->setCoins(3);
+    baron->setCoins(3);
+    CHECK(baron->validateInvest() == ActionStatus::NOT_SUPPORTED);  // The Baron lost the invest action
+    CHECK(general->tryInvest() == ActionStatus::OK);  // and the General gained it
+    CHECK(general->coins() == 6);  // Invested 3 for 6
+    CHECK(baron->tryArrest(*general) == ActionStatus::OK);
+    CHECK(general->coins() == 6);  // The General keeps its coin when arrested
+    spy->setCoins(3);
+    spy->setBlockedFromEconomic(true);
+    CHECK(spy->validateTax() == ActionStatus::BLOCKED_ECONOMIC);  // The sanction is reported first
+    CHECK(spy->turnIncome() == 1);  // More than 2 coins earns the Spy a coin
+
+    RuleConfig negative;
+    negative.role(Role::SPY).incomeAbove = -1;  // Thresholds are not negative either
+    CHECK_FALSE(negative.isValid());
+}
@@ -396,6 +396,9 @@ TEST_CASE("Player: Last action tracking")
     player1->coup(player2);  // Player1 performs coup on Player2
     CHECK(player1->get_last_action() == "coup");  // Verify last action is coup
     CHECK(player1->get_last_target() == "Player2");  // Verify target is Player2
+    CHECK(player1->lastActionIs(ActionType::COUP));  // The action is stored as its type
+    CHECK_FALSE(player1->lastActionIs(ActionType::TAX));
+    CHECK(player1->lastTargetSeat() == player2->seat());  // And the target as a seat
 }
 
 /**
@@ -452,3 +455,48 @@ TEST_CASE("Player: Economic actions blocked by sanction")
     CHECK_THROWS(merchant->gather());  // Verify Merchant can gather
     CHECK(merchant->coins() == 0);  // Merchant still has 0 coins
 }
+
+/**
+ * Test case that verifies the non-throwing actions report the same rules as the throwing ones.
+ * A refused action returns its status and leaves the game unchanged.
+ */
+TEST_CASE("Player: Non-throwing actions return a status")
+{
+    Game game;  // Create a new game instance
+    auto p1 = game.createPlayer("Player1", Role::GOVERNOR);  // Create first player
+    auto p2 = game.createPlayer("Player2", Role::SPY);  // Create second player
+
+    CHECK(p2->tryGather() == ActionStatus::NOT_YOUR_TURN);  // Not the second player's turn
+    CHECK(p2->coins() == 0);  // Nothing changed
+    CHECK(p1->tryBribe() == ActionStatus::NOT_ENOUGH_COINS_TO_BRIBE);  // Bribe needs 4 coins
+    CHECK(p1->tryCoup(p2) == ActionStatus::NOT_ENOUGH_COINS);  // Coup needs 7 coins
+    CHECK(p1->tryInvest() == ActionStatus::NOT_SUPPORTED);  // Only the Baron can invest
+    CHECK(p1->tryArrest(p2) == ActionStatus::TARGET_CANNOT_PAY);  // The target has no coin to lose
+    CHECK(game.turn() == Role::GOVERNOR);  // Refused actions do not end the turn
+
+    CHECK(p1->tryGather() == ActionStatus::OK);  // Legal action succeeds
+    CHECK(p1->coins() == 1);  // Player gained one coin
+    CHECK(game.turn() == Role::SPY);  // The turn moved on
+}
+
+/**
+ * Test case that verifies the throwing actions raise the exception matching the status.
+ */
+TEST_CASE("Player: Throwing actions match the status")
+{
+    Game game;  // Create a new game instance
+    auto p1 = game.createPlayer("Player1", Role::GENERAL);  // Create first player
+    auto p2 = game.createPlayer("Player2", Role::JUDGE);  // Create second player
+
+    CHECK(p2->tryTax() == ActionStatus::NOT_YOUR_TURN);  // Status of the refused action
+    CHECK_THROWS_AS(p2->tax(), InvalidTurn);  // Same rule as an exception
+
+    p1->setCoins(10);  // Force a coup
+    CHECK(p1->tryGather() == ActionStatus::MUST_COUP);  // Status of the refused action
+    CHECK_THROWS_AS(p1->gather(), InvalidOperation);  // Same rule as an exception
+
+    p1->setCoins(3);  // Not enough to sanction a Judge
+    CHECK(p1->trySanction(*p2) == ActionStatus::NOT_ENOUGH_COINS);  // Sanctioning a Judge costs 4
+    CHECK_THROWS_AS(p1->sanction(*p2), NotEnoughCoins);  // Same rule as an exception
+    CHECK(p1->coins() == 3);  // Nothing was paid
+}
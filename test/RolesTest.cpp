@@ -153,6 +153,49 @@ TEST_CASE("Merchant: React to arrest with few coins")
     CHECK(general->coins() == 2);  // Verify General's coins remain unchanged
 }
 
+/**
+ * Test case that verifies the Merchant's passive income when their turn ends.
+ * A Merchant with more than 3 coins receives one extra coin, and the event is
+ * reported through the game's log hook.
+ */
+TEST_CASE("Merchant: Turn income with more than 3 coins")
+{
+    Game game;  // Create a new game instance
+    auto merchant = game.createPlayer("Merchant", Role::MERCHANT);  // Create a Merchant
+    auto spy = game.createPlayer("Spy", Role::SPY);  // Create a Spy
+
+    vector<string> messages;  // Messages received by the log hook
+    game.setLogHook([&messages](const string &message) { messages.push_back(message); });
+    CHECK(game.isLoggingEnabled());  // The hook is set
+
+    merchant->setCoins(4);  // Eligible for income
+    merchant->gather();  // 4 + 1 from gather + 1 income
+    CHECK(merchant->coins() == 6);  // Merchant received the income
+    CHECK(messages.size() == 1);  // One income event was logged
+}
+
+/**
+ * Test case that verifies a Merchant with 3 coins or fewer receives no income
+ * and that nothing is logged or thrown.
+ */
+TEST_CASE("Merchant: No turn income with 3 coins or fewer")
+{
+    Game game;  // Create a new game instance
+    auto merchant = game.createPlayer("Merchant", Role::MERCHANT);  // Create a Merchant
+    auto spy = game.createPlayer("Spy", Role::SPY);  // Create a Spy
+
+    vector<string> messages;  // Messages received by the log hook
+    game.setLogHook([&messages](const string &message) { messages.push_back(message); });
+
+    merchant->setCoins(2);  // Not eligible for income
+    CHECK_NOTHROW(merchant->gather());  // 2 + 1 from gather
+    CHECK(merchant->coins() == 3);  // No income
+    CHECK(messages.empty());  // Nothing was logged
+
+    game.setLogHook(nullptr);  // Disable logging
+    CHECK_FALSE(game.isLoggingEnabled());  // The hook is cleared
+}
+
 // ==================== GENERAL TESTS ====================
 
 /**
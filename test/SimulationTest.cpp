@@ -0,0 +1,734 @@
+//orel8155@gmail.com
+/**
+ * @file SimulationTest.cpp
+ * @brief Test cases for the game simulator and the batch simulation runner.
+ *
+ * This file contains test cases that verify simulated games finish correctly,
+ * that results are reproducible from their seeds, that running a batch
+ * on several threads gives the same statistics as running it on one,
+ * that the work-stealing scheduler runs every job exactly once, that the
+ * MCTS bot picks legal moves within its budget, that the transposition
+ * table stores, replaces and shares entries safely, that reused games
+ * and their arenas keep simulations off the heap, and that random streams
+ * replay every game from its seed and index.
+ */
+
+#include "doctest.h"  // Include the testing framework
+
+#include "../src/Game.hpp"  // Include the Game class
+#include "../src/GameSimulator.hpp"  // Include the random-policy simulator
+#include "../src/SimulationRunner.hpp"  // Include the batch runner
+#include "../src/WorkStealingScheduler.hpp"  // Include the work-stealing scheduler
+#include "../src/MctsBot.hpp"  // Include the MCTS bot
+#include "../src/TranspositionTable.hpp"  // Include the transposition table
+#include "../src/Rng.hpp"  // Include the random streams
+#include <cstring>  // For memcmp
+#include "../src/GameExceptions.hpp"  // Include custom exceptions
+#include <atomic>  // For per-job counters
+#include <thread>  // For uneven job durations
+#include <chrono>  // For sleep durations
+#include <cstdlib>  // For malloc in the counting operator new
+#include <new>  // For bad_alloc
+#include <limits>  // For the largest size_t
+#include <mutex>  // For collecting ranges
+
+using namespace coup;  // Use the coup namespace
+using namespace std;  // Use the standard namespace
+
+/**
+ * Number of calls to the global operator new, used to check that reused games do not allocate.
+ */
+static atomic<size_t> allocationCount{0};
+
+void *operator new(size_t size)
+{
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void *memory = malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    free(memory);
+}
+
+// The over-aligned forms are counted too: pmr resources take their memory through them
+void *operator new(size_t size, align_val_t alignment)
+{
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    size_t align = static_cast<size_t>(alignment);
+    if (void *memory = aligned_alloc(align, (size + align - 1) / align * align))
+    {
+        return memory;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void *memory, align_val_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void *memory, size_t, align_val_t) noexcept
+{
+    free(memory);
+}
+
+/**
+ * Helper that compares two batches of statistics field by field.
+ */
+static void checkSameStats(const SimulationStats &a, const SimulationStats &b)
+{
+    CHECK(a.games == b.games);  // Same number of games
+    CHECK(a.completed == b.completed);  // Same number of finished games
+    CHECK(a.stalemates == b.stalemates);  // Same number of stalemates
+    CHECK(a.turnLimit == b.turnLimit);  // Same number of games stopped by the limit
+    CHECK(a.totalTurns == b.totalTurns);  // Same total number of turns
+    CHECK(a.winsByRole == b.winsByRole);  // Same wins per role
+}
+
+/**
+ * Test case that verifies a simulated game with the same seed is reproducible.
+ */
+TEST_CASE("Simulation: Same seed gives the same game")
+{
+    vector<Role> roles = {Role::GENERAL, Role::MERCHANT, Role::GOVERNOR, Role::SPY};
+
+    SimulationResult first = playSimulatedGame(roles, 1234, 300);  // Play a game
+    SimulationResult second = playSimulatedGame(roles, 1234, 300);  // Replay it with the same seed
+
+    CHECK(first.completed == second.completed);  // Same outcome
+    CHECK(first.turns == second.turns);  // Same length
+    CHECK(first.winnerIndex == second.winnerIndex);  // Same winner
+}
+
+/**
+ * Test case that verifies a reused context plays the same games as new ones and stops allocating after warm-up.
+ */
+TEST_CASE("Simulation: Reused games match new games without allocating")
+{
+    vector<Role> roles = {Role::GENERAL, Role::GOVERNOR, Role::SPY, Role::BARON, Role::JUDGE, Role::MERCHANT};
+    MctsConfig bot;
+    bot.maxPlayouts = 50;
+    SimulationContext random(roles, 300);  // Random policy on every seat
+    SimulationContext searching(roles, 300, 0b10, bot);  // The Governor is played by the bot
+
+    for (unsigned int seed = 1; seed <= 10; ++seed)
+    {
+        SimulationResult fresh = playSimulatedGame(roles, seed, 300);  // A new game every time
+        SimulationResult reused = random.play(seed);  // The same game on the reset context
+        CHECK(fresh.turns == reused.turns);  // Same length
+        CHECK(fresh.winnerIndex == reused.winnerIndex);  // Same winner
+        CHECK(fresh.completed == reused.completed);  // Same outcome
+
+        fresh = playSimulatedGame(roles, seed, 300, 0b10, bot);
+        reused = searching.play(seed);
+        CHECK(fresh.turns == reused.turns);  // The reseeded bot plays like a new one
+        CHECK(fresh.winnerIndex == reused.winnerIndex);  // Same winner with the bot
+    }
+
+    size_t before = allocationCount.load();
+    for (unsigned int seed = 100; seed < 200; ++seed)
+    {
+        random.play(seed);
+    }
+    CHECK(allocationCount.load() == before);  // Warm games allocate nothing
+    searching.play(100);
+    CHECK(allocationCount.load() == before);  // Neither does a single-threaded bot
+    CHECK(random.game().hash() == random.game().computeHash());  // The last game's state is consistent
+}
+
+/**
+ * Test case that verifies players, the name index and the journal come from the game's arena instead of the heap.
+ */
+TEST_CASE("Simulation: Games allocate from their arena")
+{
+    size_t before = allocationCount.load();
+    Game game;  // Allocates the arena block and reserves the players list
+    CHECK(allocationCount.load() - before == 2);  // The only heap blocks of the game
+    for (Role role : {Role::GENERAL, Role::GOVERNOR, Role::SPY, Role::BARON, Role::JUDGE, Role::MERCHANT})
+    {
+        game.createPlayer(role_to_string(role), role);
+    }
+    for (int i = 0; i < 12; ++i)
+    {
+        CHECK(game.apply({ActionType::GATHER, NO_TARGET}) == ActionStatus::OK);  // Grows the journal
+    }
+    CHECK(allocationCount.load() - before == 2);  // Six players and a journal without a heap allocation
+    CHECK(game.getPlayerByName("Spy")->role() == Role::SPY);  // The arena-backed name index works
+    while (game.journalSize() > 0)
+    {
+        game.undoLast();
+    }
+    CHECK(game.hash() == game.computeHash());  // Undoing from the arena journal restores the game
+}
+
+/**
+ * Test case that verifies pointers to players can be released after their game
+ * is destroyed: each player keeps the game's arena alive until then.
+ */
+TEST_CASE("Simulation: Players may outlive their game")
+{
+    shared_ptr<Player> survivor;  // Created by a game that is gone by the end of the scope
+    vector<shared_ptr<Player>> copies;  // Copies of the game's own list
+    {
+        auto game = make_unique<Game>();
+        survivor = game->createPlayer("Spy", Role::SPY);
+        game->createPlayer("Judge", Role::JUDGE);
+        copies = game->getPlayers();
+        game->reset({Role::BARON, Role::MERCHANT}, {"Baron", "Merchant"});  // The old players are replaced
+        copies.push_back(game->getPlayerByName("Baron"));
+    }
+    CHECK(survivor.use_count() == 2);  // Held here and in the copies
+    CHECK(copies.size() == 3);  // Two replaced players and one of the last roster
+    copies.clear();
+    survivor.reset();  // The last player frees into its arena, then releases the arena
+    CHECK((survivor == nullptr));
+}
+
+/**
+ * Test case that verifies a game switching back and forth between rosters
+ * reuses the memory of the replaced players instead of growing.
+ */
+TEST_CASE("Simulation: Roster changes reuse player memory")
+{
+    const vector<Role> firstRoles = {Role::GENERAL, Role::SPY, Role::BARON};
+    const vector<string> firstNames = {"General", "Spy", "Baron"};
+    const vector<Role> secondRoles = {Role::GOVERNOR, Role::JUDGE, Role::MERCHANT};
+    const vector<string> secondNames = {"Governor", "Judge", "Merchant"};
+
+    Game game;  // Create a new game instance
+    for (int i = 0; i < 4; ++i)
+    {
+        game.reset(firstRoles, firstNames);  // Warm up the pool with both rosters
+        game.reset(secondRoles, secondNames);
+    }
+
+    size_t before = allocationCount.load();
+    for (int i = 0; i < 2000; ++i)
+    {
+        game.reset(firstRoles, firstNames);
+        game.reset(secondRoles, secondNames);
+    }
+    CHECK(allocationCount.load() == before);  // Replaced players are recycled, nothing new is allocated
+    CHECK(game.players() == secondNames);  // The last roster is seated
+    CHECK(game.getPlayerByName("Judge")->role() == Role::JUDGE);  // The recycled name index works
+}
+
+/**
+ * Test case that verifies the statistics of a batch add up.
+ */
+TEST_CASE("Simulation: Batch statistics are consistent")
+{
+    SimulationConfig config;
+    config.roles = {Role::GENERAL, Role::MERCHANT, Role::JUDGE};
+    config.games = 50;
+    config.seed = 7;
+    config.threads = 1;
+
+    SimulationStats stats = runSimulations(config);  // Run the batch
+
+    CHECK(stats.games == 50);  // Every game is counted
+    CHECK(stats.completed + stats.turnLimit == stats.games);  // Every game either ends or hits the limit
+
+    size_t wins = 0;
+    for (size_t count : stats.winsByRole)
+    {
+        wins += count;
+    }
+    CHECK(wins == stats.completed);  // Every finished game has exactly one winner
+}
+
+/**
+ * Test case that verifies the merged results do not depend on the thread count.
+ */
+TEST_CASE("Simulation: Parallel batch matches single-threaded batch")
+{
+    SimulationConfig config;
+    config.roles = {Role::GENERAL, Role::MERCHANT, Role::GOVERNOR, Role::SPY, Role::BARON, Role::JUDGE};
+    config.games = 60;
+    config.seed = 42;
+
+    config.threads = 1;
+    SimulationStats single = runSimulations(config);  // Run on one thread
+
+    config.threads = 4;
+    SimulationStats parallel = runSimulations(config);  // Run on four threads
+
+    checkSameStats(single, parallel);
+}
+
+/**
+ * Test case that verifies a batch plays its rule values on every thread.
+ */
+TEST_CASE("Simulation: Batch with run-time rule values")
+{
+    SimulationConfig config;
+    config.roles = {Role::GENERAL, Role::MERCHANT, Role::GOVERNOR, Role::SPY, Role::BARON, Role::JUDGE};
+    config.games = 60;
+    config.seed = 42;
+    config.threads = 1;
+    SimulationStats standard = runSimulations(config);  // Standard rules
+
+    config.rules.coupCost = 5;
+    SimulationStats cheap = runSimulations(config);  // Cheaper coups end games sooner
+    CHECK(cheap.totalTurns < standard.totalTurns);
+
+    config.threads = 4;
+    checkSameStats(cheap, runSimulations(config));  // Same results on more threads
+
+    config.rules.mustCoupCoins = 3;  // Below the coup cost
+    CHECK_THROWS_AS(runSimulations(config), GameException);  // Invalid values are rejected
+}
+
+/**
+ * Test case that verifies random streams are reproducible from (seed, stream) and split by jumps.
+ */
+TEST_CASE("Random streams: Seeding, jumps and bounded draws")
+{
+    Rng first(42, 7);
+    Rng second(42, 7);
+    CHECK(first == second);  // Same seed and stream, same state
+    for (int i = 0; i < 100; ++i)
+    {
+        REQUIRE(first() == second());
+    }
+    CHECK(Rng(42, 7)() != Rng(42, 8)());  // Neighbouring streams differ
+    CHECK(Rng(42, 7)() != Rng(43, 7)());  // So do neighbouring seeds
+    CHECK(Rng(1, 2)() != Rng(2, 1)());  // And swapped pairs
+
+    Rng jumped = first;
+    jumped.jump();
+    CHECK(jumped != first);  // A jump moves the state
+    Rng longJumped = first;
+    longJumped.longJump();
+    CHECK(longJumped != jumped);
+    Rng again = first;
+    again.jump();
+    CHECK(again == jumped);  // Jumps are deterministic
+
+    int counts[6] = {};
+    Rng rng(3);
+    for (int i = 0; i < 60000; ++i)
+    {
+        uint32_t value = rng.below(6);
+        REQUIRE(value < 6);  // In range
+        counts[value]++;
+    }
+    for (int count : counts)
+    {
+        CHECK(count > 9500);  // Roughly uniform
+        CHECK(count < 10500);
+    }
+    CHECK(rng.below(1) == 0);  // A single value
+
+    double sum = 0;
+    for (int i = 0; i < 10000; ++i)
+    {
+        double value = rng.uniform();
+        REQUIRE(value >= 0.0);
+        REQUIRE(value < 1.0);
+        sum += value;
+    }
+    CHECK(sum / 10000 == doctest::Approx(0.5).epsilon(0.02));  // Centred on one half
+}
+
+/**
+ * Test case that verifies each game of a batch is reproducible from the master seed and its index alone.
+ */
+TEST_CASE("Simulation: Games replay from the seed and their index")
+{
+    SimulationConfig config;
+    config.roles = {Role::GENERAL, Role::MERCHANT, Role::GOVERNOR, Role::SPY};
+    config.games = 20;
+    config.seed = 0x123456789ABCull;  // Seeds are 64 bits
+    config.threads = 3;
+    SimulationStats batch = runSimulations(config);
+
+    SimulationStats replayed;
+    for (uint64_t index = 0; index < config.games; ++index)
+    {
+        replayed.record(playSimulatedGame(config.roles, config.seed, config.maxTurns, 0, MctsConfig(), RuleConfig(), index));
+    }
+    checkSameStats(batch, replayed);  // Any game can be replayed on its own
+    CHECK(Rng(config.seed + 1, 0)() != Rng(config.seed, 1)());  // Game 0 of the next seed is not game 1 of this one
+}
+
+/**
+ * Test case that verifies an invalid roster is rejected.
+ */
+TEST_CASE("Simulation: Invalid roster")
+{
+    SimulationConfig config;
+    config.roles = {Role::GENERAL};  // Only one player
+    CHECK_THROWS_AS(runSimulations(config), GameException);  // Should throw exception
+}
+
+/**
+ * Test case that verifies every job index is run exactly once, even when
+ * jobs have very different lengths and chunks get stolen.
+ */
+TEST_CASE("Scheduler: Every job runs exactly once")
+{
+    const size_t jobs = 500;
+    vector<atomic<int>> runs(jobs);  // How many times each job ran
+    for (auto &count : runs)
+    {
+        count = 0;
+    }
+
+    atomic<bool> badWorker{false};  // Set if a worker index is out of range
+
+    WorkStealingScheduler scheduler(4);  // Four workers
+    scheduler.parallelFor(jobs, 3, [&runs, &badWorker](size_t first, size_t last, unsigned int worker) {
+        if (worker >= 4)
+        {
+            badWorker = true;
+        }
+        for (size_t i = first; i < last; ++i)
+        {
+            // The first jobs are much slower, so their owner falls behind
+            if (i < 20)
+            {
+                this_thread::sleep_for(chrono::microseconds(500));
+            }
+            runs[i]++;
+        }
+    });
+
+    bool allOnce = true;
+    for (auto &count : runs)
+    {
+        allOnce = allOnce && count == 1;
+    }
+    CHECK(allOnce);  // Every job ran once
+    CHECK_FALSE(badWorker);  // Worker indices were in range
+}
+
+/**
+ * Test case that verifies an exception thrown by a job reaches the caller.
+ */
+TEST_CASE("Scheduler: Job exceptions are propagated")
+{
+    WorkStealingScheduler scheduler(2);  // Two workers
+    CHECK_THROWS_AS(scheduler.parallelFor(10, 1, [](size_t first, size_t, unsigned int) {
+        if (first == 5)
+        {
+            throw GameException("job failed");
+        }
+    }), GameException);  // Should throw exception
+}
+
+/**
+ * Test case that verifies chunk counts do not wrap around when the job count
+ * or the chunk size is close to the largest size_t.
+ */
+TEST_CASE("Scheduler: Huge counts and chunk sizes")
+{
+    WorkStealingScheduler scheduler(2);  // Two workers
+    const size_t huge = numeric_limits<size_t>::max();
+
+    vector<pair<size_t, size_t>> ranges;  // Ranges of the single-chunk batch
+    scheduler.parallelFor(5, huge, [&ranges](size_t first, size_t last, unsigned int) {
+        ranges.emplace_back(first, last);
+    });
+    REQUIRE(ranges.size() == 1);  // One chunk holds every job
+    CHECK(ranges[0].first == 0);  // The chunk starts at job 0
+    CHECK(ranges[0].second == 5);  // and ends at the job count
+
+    mutex lock;
+    size_t covered = 0;  // Jobs covered by the ranges (the jobs themselves are not run)
+    scheduler.parallelFor(huge - 4, huge / 2, [&lock, &covered](size_t first, size_t last, unsigned int) {
+        lock_guard<mutex> guard(lock);
+        covered += last - first;
+    });
+    CHECK(covered == huge - 4);  // Two chunks, the last one partial, cover the batch
+}
+
+/**
+ * Test case that verifies the bot returns a legal action, respects its playout
+ * budget and leaves the game exactly as it found it.
+ */
+TEST_CASE("MCTS: Search leaves the game unchanged")
+{
+    Game game;  // Create a new game instance
+    auto general = game.createPlayer("General", Role::GENERAL);
+    auto merchant = game.createPlayer("Merchant", Role::MERCHANT);
+    auto spy = game.createPlayer("Spy", Role::SPY);
+    general->setCoins(4);  // A few options for the first player
+    merchant->setCoins(4);
+    spy->setCoins(2);
+
+    GameState before = game.snapshot();  // State before the search
+
+    MctsConfig config;
+    config.maxPlayouts = 300;
+    config.seed = 3;
+    MctsBot bot(config);
+    Action action = bot.chooseAction(game);  // Search the position
+
+    GameState after = game.snapshot();  // State after the search
+    CHECK(memcmp(&before, &after, sizeof(GameState)) == 0);  // Nothing changed
+    CHECK(game.journalSize() == 0);  // The search rewound every move
+    CHECK(game.legalActions(*general).contains(action));  // The chosen action is legal
+    CHECK(bot.lastStats().playouts == 300);  // Exactly the playout budget
+    CHECK(bot.lastStats().nodes > 1);  // A tree was built
+}
+
+/**
+ * Test case that verifies the bot takes a coup that wins the game at once.
+ */
+TEST_CASE("MCTS: Finds the winning coup")
+{
+    Game game;  // Create a new game instance
+    auto baron = game.createPlayer("Baron", Role::BARON);
+    auto judge = game.createPlayer("Judge", Role::JUDGE);
+    baron->setCoins(7);  // Enough for a coup
+    judge->setCoins(6);  // The opponent could coup next turn
+
+    MctsConfig config;
+    config.maxPlayouts = 500;
+    config.seed = 11;
+    MctsBot bot(config);
+    Action action = bot.chooseAction(game);  // Search the position
+
+    CHECK(action.type == ActionType::COUP);  // The bot coups
+    CHECK(action.target == 1);  // The only opponent
+}
+
+/**
+ * Test case that verifies root- and tree-parallel searches share the playout budget and find the winning coup.
+ */
+TEST_CASE("MCTS: Parallel search")
+{
+    Game game;  // Create a new game instance
+    auto baron = game.createPlayer("Baron", Role::BARON);
+    auto judge = game.createPlayer("Judge", Role::JUDGE);
+    baron->setCoins(7);  // Enough for a coup
+    judge->setCoins(6);  // The opponent could coup next turn
+    GameState before = game.snapshot();  // State before the search
+
+    for (MctsParallelism mode : {MctsParallelism::ROOT, MctsParallelism::TREE})
+    {
+        MctsConfig config;
+        config.maxPlayouts = 600;
+        config.seed = 11;
+        config.threads = 4;
+        config.parallelism = mode;
+        MctsBot bot(config);
+        Action action = bot.chooseAction(game);  // Search the position on four threads
+
+        const MctsStats &stats = bot.lastStats();
+        size_t total = 0;
+        for (size_t playouts : stats.threadPlayouts)
+        {
+            total += playouts;
+        }
+        CHECK(stats.threadPlayouts.size() == 4);  // One count per thread
+        CHECK(stats.playouts == 600);  // Exactly the playout budget
+        CHECK(total == stats.playouts);  // The per-thread counts add up
+        CHECK(stats.nodes <= 600 + (mode == MctsParallelism::ROOT ? 4 : 1));  // At most one node per playout plus the roots
+        CHECK(action.type == ActionType::COUP);  // The bot coups
+        CHECK(action.target == 1);  // The only opponent
+    }
+
+    GameState after = game.snapshot();  // State after the searches
+    CHECK(memcmp(&before, &after, sizeof(GameState)) == 0);  // Nothing changed
+}
+
+/**
+ * Test case that verifies a time-limited search with a tiny node pool (or a
+ * node limit of 0) still returns a legal action and leaves the game unchanged,
+ * even when several threads race for the last free nodes.
+ */
+TEST_CASE("MCTS: Time-limited search with a full node pool")
+{
+    Game game;  // Create a new game instance
+    auto general = game.createPlayer("General", Role::GENERAL);
+    auto merchant = game.createPlayer("Merchant", Role::MERCHANT);
+    auto spy = game.createPlayer("Spy", Role::SPY);
+    general->setCoins(4);  // A few options for the first player
+    merchant->setCoins(4);
+    GameState before = game.snapshot();  // State before the searches
+
+    for (size_t maxNodes : {0, 1, 3})
+    {
+        MctsConfig config;
+        config.maxPlayouts = 0;  // Limited by time only
+        config.maxMillis = 20;
+        config.maxNodes = maxNodes;
+        config.threads = 4;
+        config.seed = 5;
+        MctsBot bot(config);
+        Action action = bot.chooseAction(game);  // Search on four threads sharing one small tree
+
+        CHECK(game.legalActions(*general).contains(action));  // The chosen action is legal
+        CHECK(bot.lastStats().nodes <= max<size_t>(maxNodes, 1));  // The pool never grows past its limit
+        CHECK(bot.lastStats().playouts > 0);  // Playouts go on after the pool is full
+        GameState after = game.snapshot();
+        CHECK(memcmp(&before, &after, sizeof(GameState)) == 0);  // Nothing changed
+        CHECK(game.journalSize() == 0);  // The search rewound every move
+    }
+}
+
+/**
+ * Test case that verifies a batch with a bot seat is reproducible with a playout budget.
+ */
+TEST_CASE("MCTS: Bot seats in a batch")
+{
+    SimulationConfig config;
+    config.roles = {Role::GENERAL, Role::MERCHANT, Role::SPY};
+    config.games = 4;
+    config.seed = 5;
+    config.threads = 1;
+    config.botSeats = 1u << 0;  // The General is played by the bot
+    config.bot.maxPlayouts = 40;
+
+    SimulationStats first = runSimulations(config);  // Run the batch
+    SimulationStats second = runSimulations(config);  // Run it again
+
+    checkSameStats(first, second);  // Same results
+    CHECK(first.botWins == second.botWins);  // Same bot wins
+    CHECK(first.botWins <= first.completed);  // Bot wins are finished games
+    CHECK(first.botPlayouts > 0);  // The bot searched
+}
+
+/**
+ * Test case that verifies the transposition table stores entries and counts hits.
+ */
+TEST_CASE("Transposition table: Store and probe")
+{
+    TranspositionTable table(1);  // 1 MiB
+    CHECK(table.bytes() == 1024 * 1024);  // The requested size
+    CHECK(table.entries() == 1024 * 1024 / 16);  // 16 bytes per entry
+
+    TTData data;
+    CHECK_FALSE(table.probe(0x1234, data));  // Empty table
+    TTData stored;
+    stored.visits = 42;
+    stored.value = 0.25f;
+    stored.depth = 6;
+    table.store(0x1234, stored);
+
+    REQUIRE(table.probe(0x1234, data));  // Found after the store
+    CHECK(data.visits == 42);  // Visits kept exactly
+    CHECK(data.value == doctest::Approx(0.25).epsilon(0.001));  // Value kept with 16-bit precision
+    CHECK(data.depth == 6);  // Depth kept
+    CHECK_FALSE(table.probe(0x1234 + table.entries(), data));  // Same bucket, other key
+    CHECK(table.probes() == 3);  // Every lookup counted
+    CHECK(table.hits() == 1);  // One of them found its position
+    CHECK(table.hitRate() == doctest::Approx(1.0 / 3));  // Hits per lookup
+
+    table.clear();
+    CHECK_FALSE(table.probe(0x1234, data));  // Cleared
+    CHECK(table.probes() == 1);  // Counters restarted
+}
+
+/**
+ * Test case that verifies a full bucket replaces its shallowest entry, preferring entries of older searches.
+ */
+TEST_CASE("Transposition table: Depth and age replacement")
+{
+    TranspositionTable table(1);
+    uint64_t buckets = table.entries() / TranspositionTable::BUCKET_SIZE;
+    TTData data;
+    for (uint64_t i = 0; i < TranspositionTable::BUCKET_SIZE; ++i)
+    {
+        data.depth = static_cast<uint8_t>(10 + i);  // Key 0 is the shallowest
+        table.store(i * buckets, data);  // All in bucket 0
+    }
+
+    data.depth = 20;
+    table.store(4 * buckets, data);  // Bucket is full
+    CHECK_FALSE(table.probe(0, data));  // The shallowest entry was replaced
+    CHECK(table.probe(1 * buckets, data));  // The deeper ones stay
+    CHECK(table.probe(4 * buckets, data));  // The new one is there
+
+    for (int search = 0; search < 5; ++search)
+    {
+        table.newSearch();  // The entries get old
+    }
+    data.depth = 5;
+    table.store(5 * buckets, data);  // A shallow entry of the current search
+    CHECK_FALSE(table.probe(1 * buckets, data));  // Replaces the shallowest old entry (depth 11)
+    table.store(6 * buckets, data);
+    CHECK_FALSE(table.probe(2 * buckets, data));  // Old depth 12 goes before current depth 5
+    CHECK(table.probe(5 * buckets, data));  // The current shallow entry stays
+    CHECK(table.probe(6 * buckets, data));  // The new one is there
+}
+
+/**
+ * Test case that verifies concurrent writers and readers never see an entry mixed from two writes.
+ */
+TEST_CASE("Transposition table: Concurrent access")
+{
+    TranspositionTable table(1);
+    uint64_t buckets = table.entries() / TranspositionTable::BUCKET_SIZE;
+    atomic<size_t> mismatches{0};
+
+    // Every key's visits encode the key, so a torn entry would show up as a mismatch
+    auto worker = [&](uint64_t seed)
+    {
+        uint64_t x = seed;
+        for (int i = 0; i < 20000; ++i)
+        {
+            x = x * 6364136223846793005ull + 1442695040888963407ull;
+            uint64_t key = ((x >> 33) % 64) * buckets + (x >> 60);  // Many keys fighting over a few buckets
+            TTData data;
+            if (table.probe(key, data) && data.visits != static_cast<uint32_t>(key * 2654435761u))
+            {
+                mismatches++;
+            }
+            data.visits = static_cast<uint32_t>(key * 2654435761u);
+            table.store(key, data);
+        }
+    };
+
+    vector<thread> threads;
+    for (uint64_t t = 0; t < 4; ++t)
+    {
+        threads.emplace_back(worker, t + 1);
+    }
+    for (thread &t : threads)
+    {
+        t.join();
+    }
+
+    CHECK(mismatches == 0);  // No lookup returned another key's data
+    CHECK(table.probes() == 4 * 20000);  // Every lookup was counted
+    CHECK(table.hits() > 0);  // Threads found each other's entries
+}
+
+/**
+ * Test case that verifies the bot shares statistics through a transposition table.
+ */
+TEST_CASE("MCTS: Search with a transposition table")
+{
+    Game game;  // Create a new game instance
+    auto baron = game.createPlayer("Baron", Role::BARON);
+    auto judge = game.createPlayer("Judge", Role::JUDGE);
+    baron->setCoins(7);  // Enough for a coup
+    judge->setCoins(6);  // The opponent could coup next turn
+
+    TranspositionTable table(1);
+    MctsConfig config;
+    config.maxPlayouts = 500;
+    config.seed = 11;
+    config.threads = 2;
+    config.table = &table;
+    MctsBot bot(config);
+    Action action = bot.chooseAction(game);  // Search the position
+
+    CHECK(action.type == ActionType::COUP);  // The bot still coups
+    CHECK(bot.lastStats().tableProbes > 0);  // The table was used
+    CHECK(bot.lastStats().tableHits > 0);  // Positions were seen again
+    CHECK(bot.lastStats().tableHitRate() <= 1.0);  // A rate
+}